@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script checks the collisions of the monoenergetic electrons of
+# inputs_test_1d_background_mcc_majorant_picmi.py in one step.
+# With the null-collision method, a particle collides with the probability
+# (1 - exp(-nu_max dt)) nu / nu_max, which is the exact probability
+# 1 - exp(-nu dt) when the majorant nu_max is equal to the collision frequency nu
+# (as with the local majorant at the peak of the cross-section), decreases when
+# nu_max increases, and is smaller than expected if nu_max underestimates nu.
+# The fraction of the collisions that are excitations (which reduce the energy
+# by 1 eV) must be the ratio of the excitation cross-section to the total
+# cross-section, both linearly interpolated from input grids that do not match.
+
+import sys
+
+import numpy as np
+import yt
+from scipy.constants import c, e, m_e
+
+yt.funcs.mylog.setLevel(0)
+
+gas_density = 1.0e21  # m^-3
+gas_mass = 6.67e-27  # kg
+# maximum of the total cross-section, at the peak of the excitation cross-section
+sigma_max = 1.1e-19
+
+fn_final = sys.argv[1]
+fn_initial = fn_final[:-1] + "0"
+
+ds_final = yt.load(fn_final)
+dt = float(ds_final.current_time)
+ad_initial = yt.load(fn_initial).all_data()
+ad_final = ds_final.all_data()
+
+cross_sections = {
+    process: np.loadtxt(f"{process}.dat", unpack=True)
+    for process in ["elastic", "excitation"]
+}
+
+
+def get_collision_energy(u):
+    """Collision energy (in eV), as in ParticleUtils::getCollisionEnergy"""
+    m = m_e
+    M = gas_mass
+    gamma = np.sqrt(1.0 + u**2 / c**2)
+    return (
+        2.0
+        * m
+        * M
+        * u**2
+        / (gamma + 1.0)
+        / (M + m + np.sqrt(m**2 + M**2 + 2.0 * m * M * gamma))
+        / e
+    )
+
+
+def collision_probability(nu, nu_max):
+    """Probability of collision with the null-collision method"""
+    return (1.0 - np.exp(-nu_max * dt)) * nu / nu_max
+
+
+for species in ["electrons", "electrons_offnode"]:
+    # the particles are not pushed, so the momenta only change in collisions
+    order_initial = np.argsort(ad_initial[species, "particle_id"].v)
+    order_final = np.argsort(ad_final[species, "particle_id"].v)
+    u_initial = np.array(
+        [ad_initial[species, f"particle_momentum_{d}"].v / m_e for d in "xyz"]
+    )[:, order_initial]
+    u_final = np.array(
+        [ad_final[species, f"particle_momentum_{d}"].v / m_e for d in "xyz"]
+    )[:, order_final]
+    num_particles = u_initial.shape[1]
+    assert u_final.shape[1] == num_particles
+    assert np.all(u_initial[:2] == 0.0)
+    u = u_initial[2, 0]
+    assert np.all(u_initial[2] == u)
+
+    collided = np.any(u_final != u_initial, axis=0)
+    num_collisions = np.count_nonzero(collided)
+    energy = get_collision_energy(u)
+    energy_final = get_collision_energy(np.sqrt(np.sum(u_final**2, axis=0)))
+    num_excitations = np.count_nonzero(energy_final < energy - 0.5)
+
+    sigma = {
+        process: np.interp(energy, energies, sigmas)
+        for process, (energies, sigmas) in cross_sections.items()
+    }
+    sigma_total = sum(sigma.values())
+    nu = gas_density * sigma_total * u
+    print(f"{species}: collision energy {energy} eV, cross-sections {sigma}")
+
+    # the local majorant is between nu and the global majorant
+    probability_min = collision_probability(nu, gas_density * sigma_max * u)
+    probability_max = collision_probability(nu, nu)
+    std = np.sqrt(num_particles * probability_max * (1.0 - probability_max))
+    print(
+        f"  collisions: {num_collisions}, expected: "
+        f"{num_particles * probability_min} to {num_particles * probability_max}"
+    )
+    assert num_collisions > num_particles * probability_min - 5.0 * std
+    assert num_collisions < num_particles * probability_max + 5.0 * std
+
+    # each collision is an excitation with the probability sigma_excitation/sigma
+    ratio = sigma["excitation"] / sigma_total
+    std = np.sqrt(num_collisions * ratio * (1.0 - ratio))
+    print(f"  excitations: {num_excitations}, expected: {num_collisions * ratio}")
+    assert abs(num_excitations - num_collisions * ratio) < 5.0 * std
@@ -0,0 +1,40 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This test runs the simulation of test_3d_collision_counter_based_random
+# (Coulomb collisions with warpx.counter_based_random = 1) with several
+# OpenMP threads, and checks that the momenta of the particles are exactly
+# the same as with one OpenMP thread.
+
+import os
+import sys
+
+import numpy as np
+import yt
+
+original_dir = "../test_3d_collision_counter_based_random"
+
+filename = sys.argv[1]
+ad_threads = yt.load(filename).all_data()
+ad_original = yt.load(os.path.join(original_dir, filename)).all_data()
+
+for species in ["electron", "ion"]:
+    # the particles are compared in the order of their ids
+    ids_threads = ad_threads[species, "particle_id"].v
+    ids_original = ad_original[species, "particle_id"].v
+    assert np.array_equal(np.sort(ids_threads), np.sort(ids_original))
+    order_threads = np.argsort(ids_threads)
+    order_original = np.argsort(ids_original)
+    for component in ["x", "y", "z"]:
+        field = (species, f"particle_momentum_{component}")
+        u_threads = ad_threads[field].v[order_threads]
+        u_original = ad_original[field].v[order_original]
+        print(
+            f"{species} u{component}: max difference = {np.amax(np.abs(u_threads - u_original))}"
+        )
+        assert np.array_equal(u_threads, u_original)
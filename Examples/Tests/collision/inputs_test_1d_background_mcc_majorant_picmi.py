@@ -0,0 +1,180 @@
+#!/usr/bin/env python3
+#
+# --- Input file for the null-collision method of background MCC collisions with
+# --- cross-sections given on different energy grids. Monoenergetic electrons
+# --- collide with a background gas through two processes: the energy of the first
+# --- species is at a narrow peak of the second cross-section, which is only resolved
+# --- by its own energy grid, and the energy of the second species is between the
+# --- nodes of both grids. In the analysis, the fraction of electrons that collide in
+# --- one step is compared with the exact collision probability, which only holds if
+# --- the majorant is an upper bound of the collision frequency, and the fraction of
+# --- the collisions that are excitations is compared with the ratio of the
+# --- interpolated cross-sections.
+
+import numpy as np
+
+from pywarpx import picmi
+
+constants = picmi.constants
+
+#################################
+####### GENERAL PARAMETERS ######
+#################################
+
+nz = 64
+max_grid_size = 16
+zmin = 0.0
+zmax = 1.0
+number_per_cell = 1000
+
+gas_density = 1.0e21  # m^-3
+gas_mass = 6.67e-27  # kg
+
+# collision energies of the two species, in eV
+collision_energies = {"electrons": 3.1, "electrons_offnode": 2.95}
+
+# the elastic cross-section is constant, on a grid with a step of 1 eV, and the
+# excitation cross-section is a narrow peak at 3.1 eV, on a grid with a step of
+# 0.25 eV, shifted by 0.1 eV
+elastic_energies = np.linspace(0.0, 100.0, 101)
+elastic_sigmas = np.full_like(elastic_energies, 1.0e-20)
+excitation_energies = 0.1 + 0.25 * np.arange(41)
+excitation_sigmas = np.where(np.isclose(excitation_energies, 3.1), 1.0e-19, 0.0)
+np.savetxt("elastic.dat", np.column_stack([elastic_energies, elastic_sigmas]))
+np.savetxt(
+    "excitation.dat", np.column_stack([excitation_energies, excitation_sigmas])
+)
+
+
+def get_collision_energy(u):
+    """Collision energy (in eV) of an electron with u = gamma*v on the gas at rest,
+    as in ParticleUtils::getCollisionEnergy"""
+    m = constants.m_e
+    M = gas_mass
+    gamma = np.sqrt(1.0 + u**2 / constants.c**2)
+    return (
+        2.0
+        * m
+        * M
+        * u**2
+        / (gamma + 1.0)
+        / (M + m + np.sqrt(m**2 + M**2 + 2.0 * m * M * gamma))
+        / constants.q_e
+    )
+
+
+def get_velocity(energy):
+    """Velocity (gamma*v) of an electron at the given collision energy, by bisection"""
+    u_lo, u_hi = 0.0, 0.1 * constants.c
+    for _ in range(100):
+        u_mid = 0.5 * (u_lo + u_hi)
+        if get_collision_energy(u_mid) < energy:
+            u_lo = u_mid
+        else:
+            u_hi = u_mid
+    return 0.5 * (u_lo + u_hi)
+
+
+# about 5% of the electrons at the peak collide in the time step
+collision_frequency = gas_density * 1.1e-19 * get_velocity(3.1)
+dt = 0.05 / collision_frequency
+
+#################################
+############ PLASMA #############
+#################################
+
+species = []
+collisions = []
+for name, energy in collision_energies.items():
+    electrons = picmi.Species(
+        particle_type="electron",
+        name=name,
+        warpx_do_not_push=1,
+        warpx_do_not_deposit=1,
+        initial_distribution=picmi.UniformDistribution(
+            density=1.0e10,
+            directed_velocity=[0.0, 0.0, get_velocity(energy)],
+        ),
+    )
+    species.append(electrons)
+
+    # collisions with the background gas
+    collisions.append(
+        picmi.MCCCollisions(
+            name=f"coll_{name}",
+            species=electrons,
+            background_density=gas_density,
+            background_temperature=0.0,
+            background_mass=gas_mass,
+            use_local_majorant=True,
+            scattering_processes={
+                "elastic": {"cross_section": "elastic.dat"},
+                "excitation1": {"cross_section": "excitation.dat", "energy": 1.0},
+            },
+        )
+    )
+
+#################################
+###### GRID AND SOLVER ##########
+#################################
+
+grid = picmi.Cartesian1DGrid(
+    number_of_cells=[nz],
+    warpx_max_grid_size=max_grid_size,
+    lower_bound=[zmin],
+    upper_bound=[zmax],
+    lower_boundary_conditions=["periodic"],
+    upper_boundary_conditions=["periodic"],
+    lower_boundary_conditions_particles=["periodic"],
+    upper_boundary_conditions_particles=["periodic"],
+)
+solver = picmi.ElectrostaticSolver(
+    grid=grid, method="Multigrid", required_precision=1e-6
+)
+
+#################################
+######### DIAGNOSTICS ###########
+#################################
+
+particle_diag = picmi.ParticleDiagnostic(
+    name="diag1",
+    period=1,
+    species=species,
+    data_list=["ux", "uy", "uz", "weighting"],
+)
+field_diag = picmi.FieldDiagnostic(
+    name="diag1",
+    grid=grid,
+    period=1,
+    data_list=[],
+)
+
+#################################
+####### SIMULATION SETUP ########
+#################################
+
+sim = picmi.Simulation(
+    solver=solver,
+    time_step_size=dt,
+    max_steps=1,
+    verbose=1,
+    warpx_serialize_initial_conditions=1,
+    warpx_collisions=collisions,
+)
+
+for electrons in species:
+    sim.add_species(
+        electrons,
+        layout=picmi.PseudoRandomLayout(
+            n_macroparticles_per_cell=number_per_cell, grid=grid
+        ),
+    )
+
+sim.add_diagnostic(particle_diag)
+sim.add_diagnostic(field_diag)
+
+#################################
+##### SIMULATION EXECUTION ######
+#################################
+
+sim.step(1)
@@ -0,0 +1,63 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script compares the fields computed with the direct FFT Poisson solver
+# (warpx.self_fields_direct_fft = 1, on 2 MPI ranks) to those computed with the
+# MLMG solver (on 1 MPI rank), for two species at rest with modulated densities.
+# The reference run is the test of the same name with the suffix "_mlmg".
+# The direct solver is exact (up to round-off) for the finite-difference
+# Poisson equation that MLMG solves iteratively, so that the results must agree
+# within the precision of MLMG. This covers fully periodic boundaries, and
+# periodic boundaries with non-zero Dirichlet potentials along z, in the lab
+# frame and with the relativistic solver (where the boundary potentials are
+# added separately from the space-charge field of each species).
+# In the fully periodic case, the potential is only defined up to a constant:
+# its mean value is removed before the comparison.
+
+import os
+import sys
+
+import numpy as np
+import yt
+
+yt.funcs.mylog.setLevel(0)
+
+test_name = os.path.split(os.getcwd())[1]
+filename_fft = sys.argv[1]
+filename_mlmg = f"../{test_name}_mlmg/{filename_fft}"
+periodic = test_name.endswith("_periodic")
+
+
+def read_fields(filename):
+    ds = yt.load(filename)
+    data = ds.covering_grid(
+        level=0, left_edge=ds.domain_left_edge, dims=ds.domain_dimensions
+    )
+    fields = [f for f in ["Ex", "Ez", "phi", "rho"] if ("boxlib", f) in ds.field_list]
+    return {field: data["boxlib", field].v.squeeze() for field in fields}
+
+
+fields_fft = read_fields(filename_fft)
+fields_mlmg = read_fields(filename_mlmg)
+assert fields_fft.keys() == fields_mlmg.keys()
+
+# the particles (and hence rho) must be the same in both runs
+assert np.allclose(fields_fft["rho"], fields_mlmg["rho"], rtol=1.0e-10, atol=0.0)
+
+if periodic:
+    fields_fft["phi"] -= fields_fft["phi"].mean()
+    fields_mlmg["phi"] -= fields_mlmg["phi"].mean()
+
+for field in fields_fft:
+    if field == "rho":
+        continue
+    error = np.abs(fields_fft[field] - fields_mlmg[field]).max()
+    scale = np.abs(fields_mlmg[field]).max()
+    print(f"{field}: max. relative difference between FFT and MLMG: {error / scale}")
+    assert scale > 0.0
+    assert error < 1.0e-8 * scale
@@ -0,0 +1,45 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+"""
+This script tests the extrapolated initial guess of the lab-frame MLMG solver.
+
+The initial guess only changes the starting point of the MLMG iterations, not
+the converged solution: the fields and particles must thus agree with those of
+the lab-frame test (test_3d_electrostatic_sphere_lab_frame) within the relative
+precision of the solver. The test also checks, with the PoissonSolverIterations
+reduced diagnostics, that the extrapolated guess reduces the number of MLMG
+iterations once the two previous solutions are available.
+"""
+
+import sys
+
+import numpy as np
+
+sys.path.insert(1, "../../../../warpx/Regression/Checksum/")
+from checksumAPI import evaluate_checksum
+
+# columns: step, time, number of MLMG iterations, required precision
+data = np.loadtxt("./diags/reducedfiles/mlmg_iters.txt", ndmin=2)
+iterations = data[:, 2]
+print("MLMG iterations per step:", iterations)
+assert np.all(iterations >= 0)
+
+# the first solves start from the previous solution only (or zero),
+# the subsequent ones from the extrapolation of the two previous solutions
+iterations_cold = iterations[:2].max()
+iterations_warm = iterations[2:].mean()
+print(f"iterations: first steps {iterations_cold}, then mean {iterations_warm}")
+assert iterations_warm <= iterations_cold
+
+# same converged solution as the test with the default initial guess
+evaluate_checksum(
+    test_name="test_3d_electrostatic_sphere_lab_frame",
+    output_file=sys.argv[1],
+    rtol=1.0e-6,
+)
@@ -0,0 +1,49 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script compares the fields computed with the direct FFT Poisson solver
+# (warpx.self_fields_direct_fft = 1) to those computed with the MLMG solver,
+# for a thermal plasma with periodic boundaries. Both runs are otherwise identical.
+# The direct solver is exact (up to round-off) for the finite-difference
+# Poisson equation that MLMG solves iteratively, so that the results must agree
+# within the precision of MLMG. In the fully periodic case, the potential is
+# only defined up to a constant: its mean value is removed before the comparison.
+
+import sys
+
+import numpy as np
+import yt
+
+yt.funcs.mylog.setLevel(0)
+
+filename_fft = sys.argv[1]
+filename_mlmg = "../test_2d_energy_conserving_thermal_plasma_mlmg/" + filename_fft
+
+
+def read_fields(filename):
+    ds = yt.load(filename)
+    data = ds.covering_grid(
+        level=0, left_edge=ds.domain_left_edge, dims=ds.domain_dimensions
+    )
+    return {field: data["boxlib", field].v.squeeze() for field in ["Ex", "Ez", "phi", "rho"]}
+
+
+fields_fft = read_fields(filename_fft)
+fields_mlmg = read_fields(filename_mlmg)
+
+# the particles (and hence rho) must be the same in both runs
+assert np.allclose(fields_fft["rho"], fields_mlmg["rho"], rtol=1.0e-10, atol=0.0)
+
+fields_fft["phi"] -= fields_fft["phi"].mean()
+fields_mlmg["phi"] -= fields_mlmg["phi"].mean()
+
+for field in ["Ex", "Ez", "phi"]:
+    error = np.abs(fields_fft[field] - fields_mlmg[field]).max()
+    scale = np.abs(fields_mlmg[field]).max()
+    print(f"{field}: max. relative difference between FFT and MLMG: {error / scale}")
+    assert error < 1.0e-8 * scale
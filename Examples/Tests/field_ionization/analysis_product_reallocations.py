@@ -0,0 +1,52 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script checks the output of the IonizationProductReallocations reduced
+# diagnostics, in the lab-frame ionization test (with one particle tile per box).
+# The capacity of the product tiles grows geometrically (by a factor 1.5) when
+# they are resized, so that the number of reallocations of a tile that ends up with
+# at most n products is at most 2 + log(n)/log(1.5), instead of one reallocation per step
+# with new products. Summing over the boxes gives an upper bound of the output.
+
+import sys
+
+import numpy as np
+import yt
+
+yt.funcs.mylog.setLevel(0)
+
+growth_factor = 1.5
+
+IPR = np.genfromtxt("./diags/reducedfiles/IPR.txt")
+NP = np.genfromtxt("./diags/reducedfiles/NP.txt")
+assert np.array_equal(IPR[:, 0], NP[:, 0])
+
+# columns: step, time, reallocations of the products of the ions
+reallocations = IPR[:, 2]
+# columns: step, time, total, electrons, ions (macroparticles)
+num_electrons = NP[:, 3]
+
+ds = yt.load(sys.argv[1])
+num_boxes = len(ds.index.grids)
+
+print(f"number of reallocations: {reallocations[-1]:.0f}")
+print(f"number of electrons: {num_electrons[-1]:.0f}")
+print(f"number of output intervals with new electrons: {np.count_nonzero(np.diff(num_electrons))}")
+
+# integer counter, which never decreases
+assert np.all(reallocations == np.round(reallocations))
+assert np.all(np.diff(reallocations) >= 0)
+# the ionization happened, and the first products allocated the tiles
+assert num_electrons[-1] > 0
+assert reallocations[-1] > 0
+# no reallocation without products
+assert np.all(reallocations[num_electrons == 0] == 0)
+
+bound = num_boxes * (2.0 + np.log(np.amax(num_electrons)) / np.log(growth_factor))
+print(f"upper bound with geometric growth: {bound:.0f}")
+assert reallocations[-1] <= bound
@@ -0,0 +1,53 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script compares the ionization levels of the ions of test_2d_ionization_lab
+# with tabulated ionization rates (ions.ionization_rate_table_size) and with the
+# analytic ADK rates. The tabulated rates are accurate to a fraction of a percent,
+# so the difference between the two runs is dominated by the statistical noise of
+# the ionization events, of about 0.006 on the fraction of ions at each level
+# (about 13000 ions, for a fraction up to 0.5). The fraction of ions at each level
+# must agree within 0.025 (i.e., 4 standard deviations), and the total number of
+# ionization electrons within 2%. As in analysis.py, about 32% of the ions must be
+# N5+ (Chen, JCP, 2013, figure 2).
+
+import sys
+
+import numpy as np
+import yt
+
+yt.funcs.mylog.setLevel(0)
+
+analytic_dir = "../test_2d_ionization_lab"
+
+filename = sys.argv[1]
+ad_table = yt.load(filename).all_data()
+ad_analytic = yt.load(f"{analytic_dir}/{filename}").all_data()
+
+ilev_table = ad_table["ions", "particle_ionizationLevel"].v.astype(int)
+ilev_analytic = ad_analytic["ions", "particle_ionizationLevel"].v.astype(int)
+assert ilev_table.size == ilev_analytic.size
+num_ions = ilev_table.size
+
+max_level = max(np.amax(ilev_table), np.amax(ilev_analytic))
+fraction_table = np.bincount(ilev_table, minlength=max_level + 1) / num_ions
+fraction_analytic = np.bincount(ilev_analytic, minlength=max_level + 1) / num_ions
+print(f"Number of ions: {num_ions}")
+print(f"fractions per level, tabulated rates: {fraction_table}")
+print(f"fractions per level, analytic rates:  {fraction_analytic}")
+assert np.all(np.abs(fraction_table - fraction_analytic) < 0.025)
+
+# every ionization event creates one electron
+num_electrons_table = ad_table["electrons", "particle_weight"].size
+num_electrons_analytic = ad_analytic["electrons", "particle_weight"].size
+print(f"Number of electrons: {num_electrons_table}, analytic: {num_electrons_analytic}")
+assert abs(num_electrons_table - num_electrons_analytic) < 0.02 * num_electrons_analytic
+
+N5_fraction = fraction_table[5]
+print(f"N5_fraction: {N5_fraction}")
+assert abs(N5_fraction - 0.32) / 0.32 < 0.07
@@ -0,0 +1,71 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This test checks the quantization of the fields of a diagnostics (diag2),
+# by comparing them with the same fields written without quantization (diag1):
+# - the quantized fields (including the rounding to single precision) are
+#   within the absolute and relative tolerances, exactly;
+# - the field that is not quantized (Bx) only differs by the rounding to single precision;
+# - the fields of diag2 are written in single precision.
+
+import os
+import sys
+
+import numpy as np
+import yt
+
+yt.funcs.mylog.setLevel(50)
+
+# machine epsilon of single precision
+eps32 = np.finfo(np.float32).eps
+
+fn_quantized = sys.argv[1]
+fn_reference = fn_quantized.replace("diag2", "diag1")
+
+# the FABs of the quantized diagnostics contain 4-byte reals, the others 8-byte reals
+for fn, nbytes in [(fn_quantized, 4), (fn_reference, 8)]:
+    with open(os.path.join(fn, "Level_0", "Cell_D_00000"), "rb") as f:
+        fab_header = f.readline().decode()
+    print(f"{fn}: {fab_header.strip()}")
+    assert fab_header.startswith(f"FAB (({nbytes},")
+
+ds_quantized = yt.load(fn_quantized)
+ds_reference = yt.load(fn_reference)
+grid_quantized = ds_quantized.covering_grid(
+    level=0, left_edge=ds_quantized.domain_left_edge, dims=ds_quantized.domain_dimensions
+)
+grid_reference = ds_reference.covering_grid(
+    level=0, left_edge=ds_reference.domain_left_edge, dims=ds_reference.domain_dimensions
+)
+
+# absolute and relative tolerances (0 if none)
+tolerances = {
+    "Ex": (1.0e6, 0.0),
+    "Ez": (0.0, 1.0e-3),
+    "Bx": (0.0, 0.0),
+    "rho": (1.0e-2, 1.0e-4),
+}
+for field, (abs_tol, rel_tol) in tolerances.items():
+    q = grid_quantized["boxlib", field].v
+    r = grid_reference["boxlib", field].v
+    error = np.abs(q - r)
+    # documented bounds: with both tolerances, both are satisfied at each point
+    if abs_tol > 0.0 and rel_tol > 0.0:
+        bound = np.minimum(abs_tol, rel_tol * np.abs(r))
+    elif abs_tol > 0.0:
+        bound = np.full_like(r, abs_tol)
+    elif rel_tol > 0.0:
+        bound = rel_tol * np.abs(r)
+    else:
+        # not quantized: only the rounding to single precision
+        bound = eps32 / 2.0 * np.abs(r)
+    print(f"{field}: max error = {np.amax(error)}, max error/bound = {np.amax(error / np.maximum(bound, np.finfo(float).tiny))}")
+    assert np.all(error <= bound)
+    if abs_tol > 0.0 or rel_tol > 0.0:
+        # the fields are actually quantized
+        assert np.amax(error) > eps32 * np.amax(np.abs(r))
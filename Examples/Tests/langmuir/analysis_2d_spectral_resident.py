@@ -0,0 +1,57 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This test checks that keeping the current in spectral space between the
+# current correction and the field push (psatd.spectral_resident_current = 1)
+# gives the same results as the default pipeline, whose output is read from the
+# test test_2d_langmuir_multi_psatd_current_correction (which checks the physics).
+# The two runs do the same operations in a different order, so that they only
+# differ by round-off errors.
+
+import sys
+
+import numpy as np
+import yt
+
+yt.funcs.mylog.setLevel(0)
+
+fn = sys.argv[1]
+fn_reference = "../test_2d_langmuir_multi_psatd_current_correction/" + fn
+
+ds = yt.load(fn)
+ds_reference = yt.load(fn_reference)
+ad = ds.all_data()
+ad_reference = ds_reference.all_data()
+grid = ds.covering_grid(level=0, left_edge=ds.domain_left_edge, dims=ds.domain_dimensions)
+grid_reference = ds_reference.covering_grid(
+    level=0, left_edge=ds_reference.domain_left_edge, dims=ds_reference.domain_dimensions
+)
+
+rtol = 1.0e-8
+
+
+def compare(name, data, data_reference):
+    error = np.amax(np.abs(data - data_reference))
+    scale = np.amax(np.abs(data_reference))
+    print(f"{name}: max. relative difference with the reference run: {error / scale}")
+    assert error <= rtol * scale
+
+
+for field in ["Ex", "Ey", "Ez", "jx", "jy", "jz", "rho", "divE"]:
+    compare(field, grid["boxlib", field].v, grid_reference["boxlib", field].v)
+
+for species in ["electrons", "positrons"]:
+    # sort the particles by id, since their order may differ
+    order = np.argsort(ad[species, "particle_id"].v)
+    order_reference = np.argsort(ad_reference[species, "particle_id"].v)
+    for variable in ["particle_position_x", "particle_position_y", "particle_momentum_x", "particle_momentum_z"]:
+        compare(
+            f"{species} {variable}",
+            ad[species, variable].v[order],
+            ad_reference[species, variable].v[order_reference],
+        )
@@ -0,0 +1,67 @@
+#!/usr/bin/env python3
+
+# This script checks the output of the SpectralTransformError reduced diagnostics.
+# - With double-precision transforms, the relative round-trip error of the
+#   forward and backward Fourier transforms of E and B must be at the level
+#   of double-precision round-off. Running the diagnostics must also leave
+#   the simulation unchanged, which is checked with the checksums of the
+#   test without the diagnostics.
+# - With mixed-precision transforms (psatd.do_mixed_precision = 1), the
+#   round-trip error must be at the level of single-precision round-off
+#   (and above double-precision round-off, which checks that the transforms
+#   are actually done in single precision). The fields at the end of the run
+#   must agree with those of the double-precision run within the same bound,
+#   accumulated over the steps of the run.
+
+import os
+import sys
+
+import numpy as np
+import yt
+
+sys.path.insert(1, "../../../../warpx/Regression/Checksum/")
+from checksumAPI import evaluate_checksum
+
+yt.funcs.mylog.setLevel(0)
+
+test_name = os.path.split(os.getcwd())[1]
+mixed_precision = test_name.endswith("_mixed_precision")
+
+# columns: step, time, then err_Ex, err_Ey, err_Ez, err_Bx, err_By, err_Bz
+data = np.loadtxt("./diags/reducedfiles/transform_error.txt", ndmin=2)
+errors = data[:, 2:]
+print("maximum relative round-trip error:", errors.max())
+assert errors.shape[1] == 6
+
+if not mixed_precision:
+    assert np.all(errors < 1.0e-12)
+
+    # the diagnostics must not modify the spectral fields used by the solver
+    evaluate_checksum(
+        test_name="test_2d_langmuir_multi_psatd",
+        output_file=sys.argv[1],
+    )
+else:
+    # machine epsilon of single precision
+    eps32 = np.finfo(np.float32).eps
+    # relative round-trip error: a few times eps32 per transform, with
+    # O(log(N)) error growth in the FFTs of N = 64x64 points
+    rtol_transform = 100.0 * eps32
+    assert np.all(errors < rtol_transform)
+    assert np.all(errors[:, [0, 2]] > 1.0e-12)
+
+    # 80 steps, each with a forward and backward transform of the fields
+    max_step = 80
+    rtol_fields = max_step * rtol_transform
+    fn_double = "../test_2d_langmuir_multi_psatd/" + sys.argv[1]
+    ds = yt.load(sys.argv[1])
+    ds_double = yt.load(fn_double)
+    grid = ds.covering_grid(level=0, left_edge=ds.domain_left_edge, dims=ds.domain_dimensions)
+    grid_double = ds_double.covering_grid(
+        level=0, left_edge=ds_double.domain_left_edge, dims=ds_double.domain_dimensions
+    )
+    for field in ["Ex", "Ez"]:
+        error = np.amax(np.abs(grid["boxlib", field].v - grid_double["boxlib", field].v))
+        scale = np.amax(np.abs(grid_double["boxlib", field].v))
+        print(f"{field}: max. relative difference with the double-precision run: {error / scale}")
+        assert error < rtol_fields * scale
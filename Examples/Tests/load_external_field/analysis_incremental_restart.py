@@ -0,0 +1,64 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This test restarts the simulation of test_rz_load_external_field_grid from an
+# incremental checkpoint. The checkpoint does not contain the static magnetic field,
+# which is read from the last full checkpoint. The output after restart is compared
+# with the output of the simulation without restart.
+
+import os
+import sys
+
+import numpy as np
+import yt
+
+sys.path.insert(1, "../../../../warpx/Regression/Checksum/")
+from checksumAPI import evaluate_checksum
+
+tolerance = 1.0e-12
+
+original_dir = "../test_rz_load_external_field_grid_incremental"
+chkfile = os.path.join(original_dir, "diags/chk000200")
+
+# the checkpoint used for the restart is incremental: the magnetic field is
+# not written, and is read from the last full checkpoint
+with open(os.path.join(chkfile, "IncrementalBase")) as f:
+    base_name = f.readline().strip()
+    entries = [f.readline().strip() for _ in range(int(f.readline()))]
+print(f"base checkpoint: {base_name}, entries: {entries}")
+assert base_name != "chk000200"
+for name in ["Bx_fp", "By_fp", "Bz_fp"]:
+    assert f"field 0 {name}" in entries
+    assert not os.path.exists(os.path.join(chkfile, "Level_0", name + "_H"))
+    assert os.path.exists(
+        os.path.join(original_dir, "diags", base_name, "Level_0", name + "_H")
+    )
+assert os.path.exists(os.path.join(chkfile, "Level_0", "Ex_fp_H"))
+assert os.path.exists(os.path.join(chkfile, "proton", "Header"))
+
+# compare the output after restart with the output of the original simulation
+filename = sys.argv[1]
+ds_restart = yt.load(filename)
+ds_original = yt.load(os.path.join(original_dir, filename))
+ad_restart = ds_restart.all_data()
+ad_original = ds_original.all_data()
+for field in ds_original.field_list:
+    dr = ad_restart[field].v
+    do = ad_original[field].v
+    error = np.amax(np.abs(dr - do))
+    if np.amax(np.abs(do)) != 0.0:
+        error /= np.amax(np.abs(do))
+    print(f"field: {field}; error = {error}")
+    assert error < tolerance
+
+# the physics is that of test_rz_load_external_field_grid
+evaluate_checksum(
+    test_name="test_rz_load_external_field_grid",
+    output_file=filename,
+    rtol=1e-12,
+)
@@ -0,0 +1,195 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+#
+# This script tests the in-memory checkpoints, with load balancing between
+# the checkpoint and the rollback, and with the copies mirrored to the partner
+# MPI rank. It checks that:
+# - restore_memory_checkpoint(from_partner=True) brings the step, the particles
+#   and the potential back to the state of the checkpoint, after the grids were
+#   redistributed over the MPI ranks;
+# - a rollback from a callback inside sim.step() makes the time loop continue
+#   from the restored step, and reproduces the state of the run without rollback.
+# The plasma does not use random numbers after the initialization, so that the
+# runs after the rollbacks are the same as the reference run, up to the order
+# of the deposition of the particles.
+
+import numpy as np
+from mpi4py import MPI as mpi
+
+from pywarpx import callbacks, fields, particle_containers, picmi
+
+comm = mpi.COMM_WORLD
+
+##########################
+# numerics parameters
+##########################
+
+nx = 64
+nz = 64
+xmin, xmax = 0.0, 1.0e-4
+zmin, zmax = 0.0, 1.0e-4
+dt = 1.0e-14
+
+##########################
+# numerics components
+##########################
+
+grid = picmi.Cartesian2DGrid(
+    number_of_cells=[nx, nz],
+    lower_bound=[xmin, zmin],
+    upper_bound=[xmax, zmax],
+    lower_boundary_conditions=["periodic", "periodic"],
+    upper_boundary_conditions=["periodic", "periodic"],
+    lower_boundary_conditions_particles=["periodic", "periodic"],
+    upper_boundary_conditions_particles=["periodic", "periodic"],
+    warpx_max_grid_size=16,
+    warpx_blocking_factor=16,
+)
+
+solver = picmi.ElectrostaticSolver(
+    grid=grid,
+    method="Multigrid",
+    required_precision=1e-12,
+    warpx_self_fields_verbosity=0,
+)
+
+##########################
+# physics components
+##########################
+
+# The plasma only fills the lower half of the domain in x, so that the
+# heuristic costs are unbalanced and the load balancing moves the grids
+electrons = picmi.Species(
+    particle_type="electron",
+    name="electrons",
+    initial_distribution=picmi.UniformDistribution(
+        density=1.0e22,
+        lower_bound=[xmin, None, zmin],
+        upper_bound=[0.5 * xmax, None, zmax],
+        rms_velocity=[1.0e6, 1.0e6, 1.0e6],
+    ),
+)
+ions = picmi.Species(
+    particle_type="proton",
+    name="ions",
+    initial_distribution=picmi.UniformDistribution(
+        density=1.0e22,
+        lower_bound=[xmin, None, zmin],
+        upper_bound=[0.5 * xmax, None, zmax],
+    ),
+)
+
+##########################
+# simulation setup
+##########################
+
+sim = picmi.Simulation(
+    solver=solver,
+    time_step_size=dt,
+    max_steps=20,
+    verbose=1,
+    warpx_load_balance_intervals="8:8",
+    warpx_load_balance_costs_update="heuristic",
+    warpx_load_balance_efficiency_ratio_threshold=1.0,
+    warpx_memory_checkpoint_mirror=True,
+    warpx_serialize_initial_conditions=True,
+)
+
+layout = picmi.GriddedLayout(n_macroparticle_per_cell=[2, 2], grid=grid)
+sim.add_species(electrons, layout=layout)
+sim.add_species(ions, layout=layout)
+
+sim.initialize_inputs()
+sim.initialize_warpx()
+
+warpx = sim.extension.warpx
+electron_wrapper = particle_containers.ParticleContainerWrapper("electrons")
+
+
+def gather(local_arrays):
+    """Concatenate the arrays of all the tiles of all the MPI ranks"""
+    local = np.concatenate(local_arrays) if len(local_arrays) > 0 else np.empty(0)
+    return np.concatenate(comm.allgather(local))
+
+
+def get_state():
+    """Electron data sorted by id and cpu, and the potential"""
+    idcpu = gather(electron_wrapper.get_particle_idcpu(copy_to_host=True))
+    order = np.argsort(idcpu)
+    state = {"idcpu": idcpu[order]}
+    for name, getter in [
+        ("x", electron_wrapper.get_particle_x),
+        ("z", electron_wrapper.get_particle_z),
+        ("ux", electron_wrapper.get_particle_ux),
+        ("uz", electron_wrapper.get_particle_uz),
+    ]:
+        state[name] = gather(getter(copy_to_host=True))[order]
+    state["phi"] = np.array(fields.PhiFPWrapper()[...])
+    return state
+
+
+def check_same_state(state, reference, what):
+    assert np.array_equal(state["idcpu"], reference["idcpu"]), (
+        f"{what}: different particles"
+    )
+    for name in ["x", "z", "ux", "uz", "phi"]:
+        scale = np.abs(reference[name]).max()
+        error = np.abs(state[name] - reference[name]).max()
+        print(f"{what}: {name} relative difference {error / scale}")
+        assert error <= 1.0e-8 * scale, f"{what}: different {name}"
+
+
+def get_distribution_mapping():
+    return np.array(warpx.DistributionMap(0).ProcessorMap())
+
+
+##########################
+# reference run with a checkpoint at step 5
+##########################
+
+sim.step(5)
+warpx.save_memory_checkpoint()
+assert warpx.has_memory_checkpoint
+state_5 = get_state()
+dm_5 = get_distribution_mapping()
+
+sim.step(5)
+state_10 = get_state()
+if comm.size > 1:
+    # the load balancing at step 8 moved grids to the other rank
+    assert not np.array_equal(get_distribution_mapping(), dm_5)
+
+##########################
+# rollback from the copies held by the partner ranks
+##########################
+
+warpx.restore_memory_checkpoint(from_partner=True)
+assert warpx.getistep(lev=0) == 5
+check_same_state(get_state(), state_5, "restore from partner")
+
+##########################
+# rollback from a callback during the time loop
+##########################
+
+rolled_back = []
+
+
+def roll_back_once():
+    if not rolled_back and warpx.getistep(lev=0) == 8:
+        rolled_back.append(True)
+        warpx.restore_memory_checkpoint()
+
+
+callbacks.installafterstep(roll_back_once)
+# steps 6 to 8, rollback to step 5, then steps 6 to 10
+sim.step(5)
+callbacks.uninstallcallback("afterstep", roll_back_once)
+
+assert rolled_back
+assert warpx.getistep(lev=0) == 10
+check_same_state(get_state(), state_10, "rollback in callback")
@@ -0,0 +1,32 @@
+#!/usr/bin/env python3
+
+# This script tests the buffering of the reduced diagnostics (<reduced_diags_name>.flush_interval)
+# and their binary output (<reduced_diags_name>.format = binary).
+# The outputs written with buffering, in text and binary formats, must be identical
+# to the outputs written at each step, and no output must be lost at the end of the run.
+
+import numpy as np
+
+max_step = 3
+
+# reference, written at each step
+NP = np.genfromtxt("./diags/reducedfiles/NP.txt")
+assert NP.shape[0] == max_step
+
+# buffered, in text format
+NP_buffered = np.genfromtxt("./diags/reducedfiles/NP_buffered.txt")
+assert np.array_equal(NP_buffered, NP)
+
+# buffered, in binary format
+with open("./diags/reducedfiles/NP_binary.bin", "rb") as f:
+    assert f.readline().decode().strip() == "WarpX reduced diagnostics binary 1"
+    ncols = int(f.readline().decode())
+    f.readline()  # column names
+    NP_binary = np.fromfile(f, dtype=np.float64).reshape(-1, ncols)
+assert np.allclose(NP_binary, NP, rtol=1e-12, atol=0.0)
+
+# LoadBalanceCosts formats its rows itself, and rewrites its file at the last step
+with open("./diags/reducedfiles/LBC.txt") as f:
+    LBC_rows = [line for line in f.readlines() if not line.startswith("#")]
+assert len(LBC_rows) == max_step
+assert [int(row.split()[0]) for row in LBC_rows] == list(range(1, max_step + 1))
@@ -0,0 +1,84 @@
+#!/usr/bin/env python3
+#
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+# This script checks the resampling algorithms that merge clusters of particles
+# into pairs of particles (velocity_coincidence_thinning and velocity_octree_merging).
+# The particles are not pushed, and are resampled once between the first and the
+# last output. In each cell, the total weight, momentum and kinetic energy must be
+# conserved (up to round-off), and with velocity_octree_merging, the number of
+# particles must be reduced to at most the target number of particles per cell
+# (and not much fewer).
+
+import sys
+
+import numpy as np
+import yt
+from scipy.constants import c, m_p
+
+yt.funcs.mylog.setLevel(0)
+
+fn_final = sys.argv[1]
+fn_initial = fn_final[:-4] + "0000"
+
+ncells = 32
+zmin, zmax = 0.0, 0.1
+ppc_initial = 1000
+target_ppc = {"octree": 50}
+rtol = 1.0e-10
+
+
+def cell_totals(ad, species):
+    """Number of particles, and totals of the weight, momentum and kinetic energy per cell"""
+    # in 1D, the only position component (z) is stored as particle_position_x
+    z = ad[species, "particle_position_x"].v
+    w = ad[species, "particle_weight"].v
+    p = np.array([ad[species, f"particle_momentum_{d}"].v for d in "xyz"])
+    p2c2 = np.sum(p**2, axis=0) * c**2
+    mc2 = m_p * c**2
+    # kinetic energy, without cancellation for non-relativistic particles
+    energy = p2c2 / (np.sqrt(p2c2 + mc2**2) + mc2)
+    cell = np.clip(((z - zmin) / (zmax - zmin) * ncells).astype(int), 0, ncells - 1)
+
+    def per_cell(values):
+        return np.bincount(cell, weights=values, minlength=ncells)
+
+    return {
+        "number": np.bincount(cell, minlength=ncells),
+        "weight": per_cell(w),
+        "px": per_cell(w * p[0]),
+        "py": per_cell(w * p[1]),
+        "pz": per_cell(w * p[2]),
+        "energy": per_cell(w * energy),
+    }
+
+
+ad_initial = yt.load(fn_initial).all_data()
+ad_final = yt.load(fn_final).all_data()
+
+for species in ["coincidence", "octree"]:
+    initial = cell_totals(ad_initial, species)
+    final = cell_totals(ad_final, species)
+
+    print(f"{species}: particles per cell {initial['number'].mean()} -> {final['number'].mean()}")
+    assert np.all(initial["number"] == ppc_initial)
+    assert np.all(final["number"] < initial["number"])
+
+    for quantity in ["weight", "energy"]:
+        error = np.amax(np.abs(final[quantity] - initial[quantity]) / initial[quantity])
+        print(f"  {quantity}: max. relative error {error}")
+        assert error < rtol
+    # the momentum is compared with the typical momentum of the particles
+    p_scale = np.sqrt(2.0 * m_p * initial["energy"] * initial["weight"])
+    for quantity in ["px", "py", "pz"]:
+        error = np.amax(np.abs(final[quantity] - initial[quantity]) / p_scale)
+        print(f"  {quantity}: max. relative error {error}")
+        assert error < rtol
+
+    if species in target_ppc:
+        assert np.all(final["number"] <= target_ppc[species])
+        assert np.all(final["number"] >= target_ppc[species] // 2)
@@ -0,0 +1,54 @@
+#!/usr/bin/env python3
+
+# This script checks that the output data written with warpx.io_aggregation_factor > 1
+# (i.e., gathered on a subset of the MPI ranks before being written) is identical
+# to the output data of the same simulation written by all MPI ranks.
+# For the restart test, this also checks that the checkpoint written with
+# aggregation can be read back.
+
+import os
+import sys
+
+import numpy as np
+import yt
+
+filename = sys.argv[1]
+tolerance = 1e-12
+
+# output data of the same simulation, written without aggregation
+benchmark = os.path.join("..", "test_3d_acceleration", filename)
+
+
+def load_covering_grid(path):
+    ds = yt.load(path)
+    # yt 4.0+ has rounding issues with our domain data:
+    # RuntimeError: yt attempted to read outside the boundaries
+    # of a non-periodic domain along dimension 0.
+    if "force_periodicity" in dir(ds):
+        ds.force_periodicity()
+    ad = ds.covering_grid(
+        level=0, left_edge=ds.domain_left_edge, dims=ds.domain_dimensions
+    )
+    return ds, ad
+
+
+ds_benchmark, ad_benchmark = load_covering_grid(benchmark)
+ds_aggregated, ad_aggregated = load_covering_grid(filename)
+
+# The box arrays are not modified by the aggregation
+assert ds_aggregated.index.num_grids == ds_benchmark.index.num_grids
+
+# Loop over all fields (all particle species, all particle attributes, all grid fields)
+print(f"\ntolerance = {tolerance}")
+for field in ds_benchmark.field_list:
+    da = ad_aggregated[field].squeeze().v
+    db = ad_benchmark[field].squeeze().v
+    # particles may be written in a different order
+    if field[0] != "boxlib":
+        da = np.sort(da)
+        db = np.sort(db)
+    error = np.amax(np.abs(da - db))
+    if np.amax(np.abs(db)) != 0.0:
+        error /= np.amax(np.abs(db))
+    print(f"field: {field}; error = {error}")
+    assert error < tolerance
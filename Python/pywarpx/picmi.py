@@ -1433,12 +1433,20 @@ class ElectromagneticSolver(picmistandard.PICMI_ElectromagneticSolver):
         Whether to do the current correction for the spectral solver.
         See documentation for exceptions to the default value.
 
+    warpx_psatd_spectral_resident_current: bool, default=False
+        Whether to keep the corrected current in spectral space and
+        transform it back only when needed by the diagnostics
+
     warpx_psatd_update_with_rho: bool, optional
         Whether to update with the actual rho for the spectral solver
 
     warpx_psatd_do_time_averaging: bool, optional
         Whether to do the time averaging for the spectral solver
 
+    warpx_psatd_do_mixed_precision: bool, optional
+        Whether to perform the Fourier transforms of the spectral solver
+        in single precision, while the fields are stored in double precision
+
     warpx_psatd_J_in_time: {'constant', 'linear'}, default='constant'
         This determines whether the current density is assumed to be constant
         or linear in time, within the time step over which the electromagnetic
@@ -1474,8 +1482,14 @@ class ElectromagneticSolver(picmistandard.PICMI_ElectromagneticSolver):
                 "warpx_periodic_single_box_fft", None
             )
             self.psatd_current_correction = kw.pop("warpx_current_correction", None)
+            self.psatd_spectral_resident_current = kw.pop(
+                "warpx_psatd_spectral_resident_current", None
+            )
             self.psatd_update_with_rho = kw.pop("warpx_psatd_update_with_rho", None)
             self.psatd_do_time_averaging = kw.pop("warpx_psatd_do_time_averaging", None)
+            self.psatd_do_mixed_precision = kw.pop(
+                "warpx_psatd_do_mixed_precision", None
+            )
             self.psatd_J_in_time = kw.pop("warpx_psatd_J_in_time", None)
             self.psatd_rho_in_time = kw.pop("warpx_psatd_rho_in_time", None)
 
@@ -1491,8 +1505,12 @@ class ElectromagneticSolver(picmistandard.PICMI_ElectromagneticSolver):
         if self.method == "PSATD":
             pywarpx.psatd.periodic_single_box_fft = self.psatd_periodic_single_box_fft
             pywarpx.psatd.current_correction = self.psatd_current_correction
+            pywarpx.psatd.spectral_resident_current = (
+                self.psatd_spectral_resident_current
+            )
             pywarpx.psatd.update_with_rho = self.psatd_update_with_rho
             pywarpx.psatd.do_time_averaging = self.psatd_do_time_averaging
+            pywarpx.psatd.do_mixed_precision = self.psatd_do_mixed_precision
             pywarpx.psatd.J_in_time = self.psatd_J_in_time
             pywarpx.psatd.rho_in_time = self.psatd_rho_in_time
 
@@ -1880,6 +1898,18 @@ class ElectrostaticSolver(picmistandard.PICMI_ElectrostaticSolver):
     warpx_self_fields_verbosity: integer, default=2
         Level of verbosity for the lab frame solver
 
+    warpx_self_fields_direct_fft: bool, default=False
+        Whether to use a direct FFT solve instead of the multigrid solver,
+        when the boundaries are periodic (or periodic except in one direction with PEC boundaries).
+        The FFTs are computed on a single MPI rank
+
+    warpx_self_fields_initial_guess: {'previous', 'zero', 'extrapolate'}, default='previous'
+        Initial guess of the multigrid solver for the lab frame solver
+
+    warpx_self_fields_adaptive_tolerance_factor: float, default=0.
+        If positive, the relative tolerance of the lab frame solver is relaxed
+        up to this factor times the estimated particle noise level
+
     warpx_dt_update_interval: string, optional (default = -1)
         How frequently the timestep is updated. Adaptive timestepping is disabled when this is <= 0.
 
@@ -1895,6 +1925,13 @@ class ElectrostaticSolver(picmistandard.PICMI_ElectrostaticSolver):
         self.relativistic = kw.pop("warpx_relativistic", False)
         self.absolute_tolerance = kw.pop("warpx_absolute_tolerance", None)
         self.self_fields_verbosity = kw.pop("warpx_self_fields_verbosity", None)
+        self.self_fields_direct_fft = kw.pop("warpx_self_fields_direct_fft", None)
+        self.self_fields_initial_guess = kw.pop(
+            "warpx_self_fields_initial_guess", None
+        )
+        self.self_fields_adaptive_tolerance_factor = kw.pop(
+            "warpx_self_fields_adaptive_tolerance_factor", None
+        )
         self.magnetostatic = kw.pop("warpx_magnetostatic", False)
         self.cfl = kw.pop("warpx_cfl", None)
         self.dt_update_interval = kw.pop("dt_update_interval", None)
@@ -1922,6 +1959,11 @@ class ElectrostaticSolver(picmistandard.PICMI_ElectrostaticSolver):
             pywarpx.warpx.self_fields_absolute_tolerance = self.absolute_tolerance
             pywarpx.warpx.self_fields_max_iters = self.maximum_iterations
             pywarpx.warpx.self_fields_verbosity = self.self_fields_verbosity
+            pywarpx.warpx.self_fields_direct_fft = self.self_fields_direct_fft
+            pywarpx.warpx.self_fields_initial_guess = self.self_fields_initial_guess
+            pywarpx.warpx.self_fields_adaptive_tolerance_factor = (
+                self.self_fields_adaptive_tolerance_factor
+            )
             pywarpx.boundary.potential_lo_x = self.grid.potential_xmin
             pywarpx.boundary.potential_lo_y = self.grid.potential_ymin
             pywarpx.boundary.potential_lo_z = self.grid.potential_zmin
@@ -2317,6 +2359,10 @@ class MCCCollisions(picmistandard.base._ClassWithInit):
         The maximum background density. When the background_density is an expression, this must also
         be specified.
 
+    use_local_majorant: bool, optional
+        Whether to calculate the maximum collision frequency for each tile,
+        from the local background density and particle energies.
+
     ndt: integer, optional
         The collisions will be applied every "ndt" steps. Must be 1 or larger.
     """
@@ -2330,6 +2376,7 @@ class MCCCollisions(picmistandard.base._ClassWithInit):
         scattering_processes,
         background_mass=None,
         max_background_density=None,
+        use_local_majorant=None,
         ndt=None,
         **kw,
     ):
@@ -2340,6 +2387,7 @@ class MCCCollisions(picmistandard.base._ClassWithInit):
         self.background_mass = background_mass
         self.scattering_processes = scattering_processes
         self.max_background_density = max_background_density
+        self.use_local_majorant = use_local_majorant
         self.ndt = ndt
 
         self.handle_init(kw)
@@ -2362,6 +2410,7 @@ class MCCCollisions(picmistandard.base._ClassWithInit):
             collision.background_temperature = self.background_temperature
         collision.background_mass = self.background_mass
         collision.max_background_density = self.max_background_density
+        collision.use_local_majorant = self.use_local_majorant
         collision.ndt = self.ndt
 
         collision.scattering_processes = self.scattering_processes.keys()
@@ -2683,6 +2732,13 @@ class Simulation(picmistandard.PICMI_Simulation):
     warpx_costs_heuristic_particles_wt: float, optional
         (See documentation)
 
+    warpx_memory_checkpoint_intervals: string, optional
+        The intervals for copying the state of the simulation to host memory
+        (see ``restore_memory_checkpoint``)
+
+    warpx_memory_checkpoint_mirror: bool, optional
+        Whether each MPI rank also keeps the in-memory checkpoint of its partner rank
+
     warpx_costs_heuristic_cells_wt: float, optional
         (See documentation)
 
@@ -2795,6 +2851,10 @@ class Simulation(picmistandard.PICMI_Simulation):
             "warpx_costs_heuristic_particles_wt", None
         )
         self.costs_heuristic_cells_wt = kw.pop("warpx_costs_heuristic_cells_wt", None)
+        self.memory_checkpoint_intervals = kw.pop(
+            "warpx_memory_checkpoint_intervals", None
+        )
+        self.memory_checkpoint_mirror = kw.pop("warpx_memory_checkpoint_mirror", None)
         self.use_fdtd_nci_corr = kw.pop("warpx_use_fdtd_nci_corr", None)
         self.amr_check_input = kw.pop("warpx_amr_check_input", None)
         self.amr_restart = kw.pop("warpx_amr_restart", None)
@@ -2866,6 +2926,9 @@ class Simulation(picmistandard.PICMI_Simulation):
         pywarpx.algo.costs_heuristic_particles_wt = self.costs_heuristic_particles_wt
         pywarpx.algo.costs_heuristic_cells_wt = self.costs_heuristic_cells_wt
 
+        pywarpx.warpx.memory_checkpoint_intervals = self.memory_checkpoint_intervals
+        pywarpx.warpx.memory_checkpoint_mirror = self.memory_checkpoint_mirror
+
         pywarpx.warpx.grid_type = self.grid_type
         pywarpx.warpx.do_current_centering = self.do_current_centering
         pywarpx.warpx.use_filter = self.use_filter
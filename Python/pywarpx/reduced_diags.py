@@ -0,0 +1,67 @@
+# Copyright 2024 The WarpX Community
+#
+# This file is part of WarpX.
+#
+# License: BSD-3-Clause-LBNL
+
+"""Reader for reduced diagnostics written with ``<reduced_diags_name>.format = binary``.
+
+The binary file starts with three text lines: a format identifier,
+the number of columns, and the header line of the text output
+(with the column names). The rows follow, as native double-precision values.
+
+Example
+-------
+
+.. code-block:: python
+
+   from pywarpx.reduced_diags import read_reduced_diags
+
+   data, names = read_reduced_diags("diags/reducedfiles/FieldEnergy.bin")
+   step, time = data[:, 0], data[:, 1]
+"""
+
+import re
+
+import numpy as np
+
+binary_format_identifier = "WarpX reduced diagnostics binary 1"
+
+
+def read_reduced_diags(filename):
+    """Read a binary reduced diagnostics file.
+
+    Parameters
+    ----------
+    filename : str
+        Path to the ``.bin`` file.
+
+    Returns
+    -------
+    data : numpy.ndarray
+        Array of shape ``(nrows, ncols)``; the first two columns are the step and the time.
+    names : list of str
+        The column names, read from the header of the text output
+        (empty if the text output had no header).
+    """
+    with open(filename, "rb") as f:
+        identifier = f.readline().decode().strip()
+        if identifier != binary_format_identifier:
+            raise ValueError(
+                f"{filename} is not a binary WarpX reduced diagnostics file"
+            )
+        ncols = int(f.readline().decode())
+        header = f.readline().decode().strip()
+        data = np.fromfile(f, dtype=np.float64)
+
+    if data.size % ncols != 0:
+        # the last row was only partially written
+        data = data[: data.size - data.size % ncols]
+    data = data.reshape(-1, ncols)
+
+    # column names are prefixed by their index, e.g., "#[0]step() [1]time(s)"
+    names = [
+        name.strip().strip(",;") for name in re.findall(r"\[\d+\]([^\[]*)", header)
+    ]
+
+    return data, names
@@ -13,6 +13,7 @@
 #include "ComputeDiagFunctors/RhoFunctor.H"
 #include "Diagnostics/Diagnostics.H"
 #include "Diagnostics/FlushFormats/FlushFormat.H"
+#include "Diagnostics/FlushFormats/FlushFormatPlotfile.H"
 #include "ComputeDiagFunctors/BackTransformParticleFunctor.H"
 #include "Fields.H"
 #include "Utils/Algorithms/IsIn.H"
@@ -1118,6 +1119,12 @@ BTDiagnostics::Flush (int i_buffer, bool force_flush)
     // Reset the buffer counter to zero after flushing out data stored in the buffer.
     ResetBufferCounter(i_buffer);
     m_field_buffer_multifab_defined[i_buffer] = 0;
+    // Release the field buffer: it is only allocated again when the next z-slice of this
+    // snapshot is back-transformed, so that snapshots that are complete, or that do not
+    // receive data yet, do not hold any memory.
+    for (auto& mf_buffer : m_mf_output[i_buffer]) {
+        mf_buffer = amrex::MultiFab();
+    }
     IncrementBufferFlushCounter(i_buffer);
     NullifyFirstFlush(i_buffer);
     // if particles are selected for output then update and reset counters
@@ -1140,6 +1147,9 @@ void BTDiagnostics::RedistributeParticleBuffer (const int i_buffer)
 
 void BTDiagnostics::MergeBuffersForPlotfile (int i_snapshot)
 {
+    // With asynchronous output, make sure the buffers are on disk before reading them back
+    FlushFormatPlotfile::WaitForAsyncWrites();
+
     // Make sure all MPI ranks wrote their files and closed it
     // Note: additionally, since a Barrier does not guarantee a FS sync
     //       on a parallel FS, we might need to add timeouts and retries
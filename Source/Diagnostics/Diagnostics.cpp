@@ -58,6 +58,8 @@ Diagnostics::BaseReadParameters ()
     pp_diag_name.query("format", m_format);
     pp_diag_name.query("dump_last_timestep", m_dump_last_timestep);
 
+    m_field_quantizer = FieldQuantizer(m_diag_name);
+
     const amrex::ParmParse pp_geometry("geometry");
     std::string dims;
     pp_geometry.get("dims", dims);
@@ -504,7 +506,7 @@ Diagnostics::InitBaseData ()
         m_flush_format = std::make_unique<FlushFormatPlotfile>() ;
     } else if (m_format == "checkpoint"){
         // creating checkpoint format
-        m_flush_format = std::make_unique<FlushFormatCheckpoint>() ;
+        m_flush_format = std::make_unique<FlushFormatCheckpoint>(m_diag_name) ;
     } else if (m_format == "ascent"){
         m_flush_format = std::make_unique<FlushFormatAscent>();
     } else if (m_format == "catalyst") {
@@ -529,6 +531,7 @@ Diagnostics::InitBaseData ()
         WARPX_ABORT_WITH_MESSAGE(
             "unknown output format");
     }
+    m_flush_format->SetSinglePrecisionFields(m_field_quantizer.singlePrecision());
 
     // allocate vector of buffers then allocate vector of levels for each buffer
     m_mf_output.resize( m_num_buffers );
@@ -603,6 +606,9 @@ Diagnostics::FilterComputePackFlush (int step, bool force_flush)
 
     for (int i_buffer = 0; i_buffer < m_num_buffers; ++i_buffer) {
         if ( !DoDump (step, i_buffer, force_flush) ) { continue; }
+        if (m_field_quantizer.isActive()) {
+            m_field_quantizer.Quantize(m_mf_output[i_buffer], m_varnames);
+        }
         Flush(i_buffer, force_flush);
     }
 }
@@ -0,0 +1,178 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "FieldQuantizer.H"
+
+#include "Utils/Parser/ParserUtils.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXProfilerWrapper.H"
+
+#include <AMReX_Array4.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_Print.H>
+#include <AMReX_Reduce.H>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+namespace
+{
+    /** Read all the entries `<prefix>.<field> = <tolerance>` */
+    std::map<std::string, amrex::Real>
+    ReadTolerances (const std::string& prefix)
+    {
+        std::map<std::string, amrex::Real> tolerances;
+        const amrex::ParmParse pp;
+        auto const prefix_len = prefix.size() + 1;
+        for (std::string k : amrex::ParmParse::getEntries(prefix)) {
+            amrex::Real tol = 0;
+            utils::parser::getWithParser(pp, k.c_str(), tol);
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(tol > 0, k + " must be positive");
+            k.erase(0, prefix_len);
+            tolerances.insert({k, tol});
+        }
+        return tolerances;
+    }
+}
+
+FieldQuantizer::FieldQuantizer (const std::string& diag_name)
+    : m_diag_name(diag_name)
+{
+    m_abs_tolerance = ReadTolerances(diag_name + ".quantization.abs_tolerance");
+    m_rel_tolerance = ReadTolerances(diag_name + ".quantization.rel_tolerance");
+
+    const amrex::ParmParse pp_diag_name(diag_name);
+    pp_diag_name.query("quantization.single_precision", m_single_precision);
+    pp_diag_name.query("quantization.verbose", m_verbose);
+
+    // The rounding to single precision alone has a relative error up to 2^-24
+    if (singlePrecision()) {
+        for (auto const& [field, tol] : m_rel_tolerance) {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                tol > std::exp2(-std::numeric_limits<float>::digits),
+                diag_name + ".quantization.rel_tolerance." + field
+                + " must be larger than the rounding error of single precision (2^-24):"
+                + " set " + diag_name + ".quantization.single_precision = 0");
+        }
+    }
+}
+
+void
+FieldQuantizer::Quantize (amrex::Vector<amrex::MultiFab>& mf,
+                          const amrex::Vector<std::string>& varnames) const
+{
+    WARPX_PROFILE("FieldQuantizer::Quantize()");
+
+    using namespace amrex::literals;
+
+    const bool single_precision = singlePrecision();
+
+    for (int comp = 0; comp < static_cast<int>(varnames.size()); ++comp)
+    {
+        const auto abs_it = m_abs_tolerance.find(varnames[comp]);
+        const auto rel_it = m_rel_tolerance.find(varnames[comp]);
+        const bool do_abs = (abs_it != m_abs_tolerance.end());
+        const bool do_rel = (rel_it != m_rel_tolerance.end());
+        // all the fields are written in single precision, even if not quantized
+        if (!do_abs && !do_rel && !single_precision) { continue; }
+
+        const amrex::Real abs_tol = do_abs ? abs_it->second : 0._rt;
+        const amrex::Real rel_tol = do_rel ? rel_it->second : 0._rt;
+        // Rounding step of the absolute quantization
+        const amrex::Real abs_step = 2._rt*abs_tol;
+        // Number of bits of the significand (after the leading bit) kept by the
+        // relative quantization, such that the relative error 2^-(nbits+1) <= tolerance
+        const int nbits = do_rel ?
+            std::max(0, static_cast<int>(std::ceil(-std::log2(rel_it->second))) - 1) : 0;
+
+        // max. absolute error, max. relative error, and whether a bound is not satisfied
+        std::array<amrex::Real,3> max_errors{0._rt, 0._rt, 0._rt};
+
+        for (auto& mf_lev : mf)
+        {
+            if (!mf_lev.ok() || comp >= mf_lev.nComp()) { continue; }
+
+            amrex::ReduceOps<amrex::ReduceOpMax, amrex::ReduceOpMax, amrex::ReduceOpMax> reduce_op;
+            amrex::ReduceData<amrex::Real, amrex::Real, amrex::Real> reduce_data(reduce_op);
+            using ReduceTuple = typename decltype(reduce_data)::Type;
+
+#ifdef AMREX_USE_OMP
+#pragma omp parallel if (amrex::Gpu::notInLaunchRegion())
+#endif
+            for (amrex::MFIter mfi(mf_lev, amrex::TilingIfNotGPU()); mfi.isValid(); ++mfi)
+            {
+                const amrex::Array4<amrex::Real> arr = mf_lev.array(mfi);
+
+                reduce_op.eval(mfi.tilebox(), reduce_data,
+                [=] AMREX_GPU_DEVICE (int i, int j, int k) -> ReduceTuple
+                {
+                    const amrex::Real v = arr(i,j,k,comp);
+                    const amrex::Real abs_v = std::abs(v);
+                    if (abs_v == 0._rt || !std::isfinite(v)) { return {0._rt, 0._rt, 0._rt}; }
+
+                    amrex::Real step = do_abs ? abs_step : 0._rt;
+                    if (do_rel) {
+                        // abs_v is in [2^e, 2^(e+1)): the last kept bit has a weight 2^(e-nbits)
+                        int e = static_cast<int>(std::floor(std::log2(abs_v)));
+                        if (abs_v < std::exp2(static_cast<amrex::Real>(e))) { --e; }
+                        const amrex::Real rel_step = std::exp2(static_cast<amrex::Real>(e - nbits));
+                        step = do_abs ? amrex::min(step, rel_step) : rel_step;
+                    }
+
+                    // Error bound at this point: both tolerances are satisfied
+                    amrex::Real bound = std::numeric_limits<amrex::Real>::max();
+                    if (do_abs) { bound = abs_tol; }
+                    if (do_rel) { bound = amrex::min(bound, rel_tol * abs_v); }
+
+                    amrex::Real vq = (step > 0._rt) ? step * std::round(v / step) : v;
+                    // Round-off in the division may exceed the bound by one ulp
+                    if (std::abs(vq - v) > bound) { vq = v; }
+                    if (single_precision) {
+                        // The cast adds an error up to |vq| 2^-24: if the bound is then
+                        // exceeded, use the closest float to v, whose error is at most
+                        // |v| 2^-24 (within the bound, unless abs_tol is smaller)
+                        amrex::Real vf = static_cast<amrex::Real>(static_cast<float>(vq));
+                        if (std::abs(vf - v) > bound) {
+                            vf = static_cast<amrex::Real>(static_cast<float>(v));
+                        }
+                        vq = vf;
+                    }
+                    arr(i,j,k,comp) = vq;
+
+                    const amrex::Real err = std::abs(vq - v);
+                    return {err, err / abs_v, (err > bound) ? 1._rt : 0._rt};
+                });
+            }
+
+            auto hv = reduce_data.value(reduce_op);
+            max_errors[0] = std::max(max_errors[0], amrex::get<0>(hv));
+            max_errors[1] = std::max(max_errors[1], amrex::get<1>(hv));
+            max_errors[2] = std::max(max_errors[2], amrex::get<2>(hv));
+        }
+
+        amrex::ParallelDescriptor::ReduceRealMax(max_errors.data(), 3);
+        // Only possible with an absolute tolerance below the single-precision
+        // rounding error of the field values
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(max_errors[2] == 0._rt,
+            m_diag_name + ": the quantization error of " + varnames[comp]
+            + " exceeds its tolerance, because of the rounding to single precision:"
+            + " increase the tolerance or set " + m_diag_name + ".quantization.single_precision = 0");
+
+        if (m_verbose) {
+            std::stringstream ss;
+            ss << m_diag_name << ": quantized " << varnames[comp]
+               << " with max absolute error " << max_errors[0]
+               << " and max relative error " << max_errors[1];
+            amrex::Print() << Utils::TextMsg::Info(ss.str());
+        }
+    }
+}
@@ -4,16 +4,21 @@
 #if (defined WARPX_DIM_RZ) && (defined WARPX_USE_FFT)
 #   include "BoundaryConditions/PML_RZ.H"
 #endif
+#include "Diagnostics/IOAggregation.H"
 #include "Diagnostics/ParticleDiag/ParticleDiag.H"
 #include "Fields.H"
 #include "Particles/WarpXParticleContainer.H"
+#include "Utils/Parser/ParserUtils.H"
 #include "Utils/TextMsg.H"
+#include "Utils/WarpXAlgorithmSelection.H"
 #include "Utils/WarpXProfilerWrapper.H"
 #include "WarpX.H"
 
 #include <ablastr/fields/MultiFabRegister.H>
 
+#include <AMReX_GpuAllocators.H>
 #include <AMReX_MultiFab.H>
+#include <AMReX_ParmParse.H>
 #include <AMReX_ParticleIO.H>
 #include <AMReX_PlotFileUtil.H>
 #include <AMReX_Print.H>
@@ -21,14 +26,25 @@
 #include <AMReX_Utility.H>
 #include <AMReX_VisMF.H>
 
+#include <fstream>
+
 using namespace amrex;
 using warpx::fields::FieldType;
+using warpx::diagnostics::VisMFWriteAggregated;
 
 namespace
 {
     const std::string default_level_prefix {"Level_"};
 }
 
+FlushFormatCheckpoint::FlushFormatCheckpoint (const std::string& diag_name)
+{
+    const amrex::ParmParse pp_diag_name(diag_name);
+    utils::parser::queryWithParser(pp_diag_name, "full_checkpoint_period", m_full_checkpoint_period);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_full_checkpoint_period >= 1,
+        diag_name + ".full_checkpoint_period must be at least 1");
+}
+
 void
 FlushFormatCheckpoint::WriteToFile (
         const amrex::Vector<std::string>& /*varnames*/,
@@ -66,88 +82,91 @@ FlushFormatCheckpoint::WriteToFile (
 
     WriteJobInfo(checkpointname);
 
+    // Gather the data on the writer ranks before writing, if requested
+    const int aggregation_factor = warpx.getIOAggregationFactor();
+
+    // With incremental checkpoints, the static fields are only written in the full
+    // checkpoints, and are read from the last full checkpoint on restart. The B field
+    // is static when it is only set from the external fields, i.e., with the lab-frame
+    // electrostatic solver (which does not compute B) or without field solver, and the
+    // E field is static without field solver. With a moving window, the fields are shifted.
+    const bool is_incremental = (m_full_checkpoint_period > 1);
+    const bool is_full = (m_num_checkpoints % m_full_checkpoint_period == 0);
+    if (is_full) {
+        m_base_checkpoint = checkpointname.substr(checkpointname.find_last_of('/') + 1);
+    }
+    const bool no_field_solve = (WarpX::electromagnetic_solver_id == ElectromagneticSolverAlgo::None)
+        && !WarpX::do_moving_window;
+    const bool static_E = no_field_solve
+        && (WarpX::electrostatic_solver_id == ElectrostaticSolverAlgo::None);
+    const bool static_B = no_field_solve
+        && (WarpX::electrostatic_solver_id == ElectrostaticSolverAlgo::None
+            || WarpX::electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrame);
+    amrex::Vector<std::string> reused;
+
+    auto const write_mf = [&] (const amrex::MultiFab& mf, int lev, const std::string& name)
+    {
+        const bool is_static = (name[0] == 'E' && static_E) || (name[0] == 'B' && static_B);
+        if (is_incremental && !is_full && is_static) {
+            reused.push_back("field " + std::to_string(lev) + " " + name);
+            return;
+        }
+        VisMFWriteAggregated(mf,
+            amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, name), aggregation_factor);
+    };
+
     for (int lev = 0; lev < nlev; ++lev)
     {
-        VisMF::Write(*warpx.m_fields.get(FieldType::Efield_fp, Direction{0}, lev),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_fp"));
-        VisMF::Write(*warpx.m_fields.get(FieldType::Efield_fp, Direction{1}, lev),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_fp"));
-        VisMF::Write(*warpx.m_fields.get(FieldType::Efield_fp, Direction{2}, lev),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_fp"));
-        VisMF::Write(*warpx.m_fields.get(FieldType::Bfield_fp, Direction{0}, lev),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_fp"));
-        VisMF::Write(*warpx.m_fields.get(FieldType::Bfield_fp, Direction{1}, lev),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_fp"));
-        VisMF::Write(*warpx.m_fields.get(FieldType::Bfield_fp, Direction{2}, lev),
-                     amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_fp"));
+        write_mf(*warpx.m_fields.get(FieldType::Efield_fp, Direction{0}, lev), lev, "Ex_fp");
+        write_mf(*warpx.m_fields.get(FieldType::Efield_fp, Direction{1}, lev), lev, "Ey_fp");
+        write_mf(*warpx.m_fields.get(FieldType::Efield_fp, Direction{2}, lev), lev, "Ez_fp");
+        write_mf(*warpx.m_fields.get(FieldType::Bfield_fp, Direction{0}, lev), lev, "Bx_fp");
+        write_mf(*warpx.m_fields.get(FieldType::Bfield_fp, Direction{1}, lev), lev, "By_fp");
+        write_mf(*warpx.m_fields.get(FieldType::Bfield_fp, Direction{2}, lev), lev, "Bz_fp");
 
         if (WarpX::fft_do_time_averaging)
         {
-            VisMF::Write(*warpx.m_fields.get(FieldType::Efield_avg_fp, Direction{0}, lev),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_avg_fp"));
-            VisMF::Write(*warpx.m_fields.get(FieldType::Efield_avg_fp, Direction{1}, lev),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_avg_fp"));
-            VisMF::Write(*warpx.m_fields.get(FieldType::Efield_avg_fp, Direction{2}, lev),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_avg_fp"));
-
-            VisMF::Write(*warpx.m_fields.get(FieldType::Bfield_avg_fp, Direction{0}, lev),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_avg_fp"));
-            VisMF::Write(*warpx.m_fields.get(FieldType::Bfield_avg_fp, Direction{1}, lev),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_avg_fp"));
-            VisMF::Write(*warpx.m_fields.get(FieldType::Bfield_avg_fp, Direction{2}, lev),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_avg_fp"));
+            write_mf(*warpx.m_fields.get(FieldType::Efield_avg_fp, Direction{0}, lev), lev, "Ex_avg_fp");
+            write_mf(*warpx.m_fields.get(FieldType::Efield_avg_fp, Direction{1}, lev), lev, "Ey_avg_fp");
+            write_mf(*warpx.m_fields.get(FieldType::Efield_avg_fp, Direction{2}, lev), lev, "Ez_avg_fp");
+
+            write_mf(*warpx.m_fields.get(FieldType::Bfield_avg_fp, Direction{0}, lev), lev, "Bx_avg_fp");
+            write_mf(*warpx.m_fields.get(FieldType::Bfield_avg_fp, Direction{1}, lev), lev, "By_avg_fp");
+            write_mf(*warpx.m_fields.get(FieldType::Bfield_avg_fp, Direction{2}, lev), lev, "Bz_avg_fp");
         }
 
         if (warpx.getis_synchronized()) {
             // Need to save j if synchronized because after restart we need j to evolve E by dt/2.
-            VisMF::Write(*warpx.m_fields.get(FieldType::current_fp, Direction{0}, lev),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jx_fp"));
-            VisMF::Write(*warpx.m_fields.get(FieldType::current_fp, Direction{1}, lev),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jy_fp"));
-            VisMF::Write(*warpx.m_fields.get(FieldType::current_fp, Direction{2}, lev),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jz_fp"));
+            write_mf(*warpx.m_fields.get(FieldType::current_fp, Direction{0}, lev), lev, "jx_fp");
+            write_mf(*warpx.m_fields.get(FieldType::current_fp, Direction{1}, lev), lev, "jy_fp");
+            write_mf(*warpx.m_fields.get(FieldType::current_fp, Direction{2}, lev), lev, "jz_fp");
         }
 
         if (lev > 0)
         {
-            VisMF::Write(*warpx.m_fields.get(FieldType::Efield_cp, Direction{0}, lev),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_cp"));
-            VisMF::Write(*warpx.m_fields.get(FieldType::Efield_cp, Direction{1}, lev),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_cp"));
-            VisMF::Write(*warpx.m_fields.get(FieldType::Efield_cp, Direction{2}, lev),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_cp"));
-            VisMF::Write(*warpx.m_fields.get(FieldType::Bfield_cp, Direction{0}, lev),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_cp"));
-            VisMF::Write(*warpx.m_fields.get(FieldType::Bfield_cp, Direction{1}, lev),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_cp"));
-            VisMF::Write(*warpx.m_fields.get(FieldType::Bfield_cp, Direction{2}, lev),
-                         amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_cp"));
+            write_mf(*warpx.m_fields.get(FieldType::Efield_cp, Direction{0}, lev), lev, "Ex_cp");
+            write_mf(*warpx.m_fields.get(FieldType::Efield_cp, Direction{1}, lev), lev, "Ey_cp");
+            write_mf(*warpx.m_fields.get(FieldType::Efield_cp, Direction{2}, lev), lev, "Ez_cp");
+            write_mf(*warpx.m_fields.get(FieldType::Bfield_cp, Direction{0}, lev), lev, "Bx_cp");
+            write_mf(*warpx.m_fields.get(FieldType::Bfield_cp, Direction{1}, lev), lev, "By_cp");
+            write_mf(*warpx.m_fields.get(FieldType::Bfield_cp, Direction{2}, lev), lev, "Bz_cp");
 
             if (WarpX::fft_do_time_averaging)
             {
-                VisMF::Write(*warpx.m_fields.get(FieldType::Efield_avg_cp, Direction{0}, lev),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ex_avg_cp"));
-                VisMF::Write(*warpx.m_fields.get(FieldType::Efield_avg_cp, Direction{1}, lev),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ey_avg_cp"));
-                VisMF::Write(*warpx.m_fields.get(FieldType::Efield_avg_cp, Direction{2}, lev),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Ez_avg_cp"));
-
-                VisMF::Write(*warpx.m_fields.get(FieldType::Bfield_avg_cp, Direction{0}, lev),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bx_avg_cp"));
-                VisMF::Write(*warpx.m_fields.get(FieldType::Bfield_avg_cp, Direction{1}, lev),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "By_avg_cp"));
-                VisMF::Write(*warpx.m_fields.get(FieldType::Bfield_avg_cp, Direction{2}, lev),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "Bz_avg_cp"));
+                write_mf(*warpx.m_fields.get(FieldType::Efield_avg_cp, Direction{0}, lev), lev, "Ex_avg_cp");
+                write_mf(*warpx.m_fields.get(FieldType::Efield_avg_cp, Direction{1}, lev), lev, "Ey_avg_cp");
+                write_mf(*warpx.m_fields.get(FieldType::Efield_avg_cp, Direction{2}, lev), lev, "Ez_avg_cp");
+
+                write_mf(*warpx.m_fields.get(FieldType::Bfield_avg_cp, Direction{0}, lev), lev, "Bx_avg_cp");
+                write_mf(*warpx.m_fields.get(FieldType::Bfield_avg_cp, Direction{1}, lev), lev, "By_avg_cp");
+                write_mf(*warpx.m_fields.get(FieldType::Bfield_avg_cp, Direction{2}, lev), lev, "Bz_avg_cp");
             }
 
             if (warpx.getis_synchronized()) {
                 // Need to save j if synchronized because after restart we need j to evolve E by dt/2.
-                VisMF::Write(*warpx.m_fields.get(FieldType::current_cp, Direction{0}, lev),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jx_cp"));
-                VisMF::Write(*warpx.m_fields.get(FieldType::current_cp, Direction{1}, lev),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jy_cp"));
-                VisMF::Write(*warpx.m_fields.get(FieldType::current_cp, Direction{2}, lev),
-                             amrex::MultiFabFileFullPrefix(lev, checkpointname, default_level_prefix, "jz_cp"));
+                write_mf(*warpx.m_fields.get(FieldType::current_cp, Direction{0}, lev), lev, "jx_cp");
+                write_mf(*warpx.m_fields.get(FieldType::current_cp, Direction{1}, lev), lev, "jy_cp");
+                write_mf(*warpx.m_fields.get(FieldType::current_cp, Direction{2}, lev), lev, "jz_cp");
             }
         }
 
@@ -171,6 +190,24 @@ FlushFormatCheckpoint::WriteToFile (
 
     WriteDMaps(checkpointname, nlev);
 
+    if (is_incremental && !is_full && amrex::ParallelDescriptor::IOProcessor()) {
+        const std::string base_filename = checkpointname + "/" + incremental_base_filename;
+        std::ofstream base_file(base_filename.c_str(), std::ios::out|std::ios::trunc);
+        if (!base_file.good()) { amrex::FileOpenFailed(base_filename); }
+        base_file << m_base_checkpoint << "\n";
+        base_file << reused.size() << "\n";
+        for (const auto& entry : reused) { base_file << entry << "\n"; }
+        base_file.close();
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(base_file.good(),
+            "FlushFormatCheckpoint::WriteToFile: problem writing " + base_filename);
+    }
+    if (is_incremental && !is_full) {
+        amrex::Print() << Utils::TextMsg::Info(
+            "Incremental checkpoint: " + std::to_string(reused.size())
+            + " static fields are read from " + m_base_checkpoint);
+    }
+    ++m_num_checkpoints;
+
     VisMF::SetHeaderVersion(current_version);
 
 }
@@ -209,8 +246,18 @@ FlushFormatCheckpoint::CheckpointParticles (
         auto runtime_inames = pc->getParticleRuntimeiComps();
         for (auto const& x : runtime_inames) { int_names[x.second+0] = x.first; }
 
-        pc->Checkpoint(dir, part_diag.getSpeciesName(), true,
-                       real_names, int_names);
+        const int aggregation_factor = WarpX::GetInstance().getIOAggregationFactor();
+        if (aggregation_factor > 1) {
+            // Gather the particles on the writer ranks, using a temporary copy
+            auto tmp = pc->make_alike<amrex::PinnedArenaAllocator>();
+            tmp.copyParticles(*pc, true);
+            warpx::diagnostics::AggregateParticles(tmp, aggregation_factor);
+            tmp.Checkpoint(dir, part_diag.getSpeciesName(), true,
+                           real_names, int_names);
+        } else {
+            pc->Checkpoint(dir, part_diag.getSpeciesName(), true,
+                           real_names, int_names);
+        }
     }
 }
 
@@ -159,8 +159,10 @@ FlushFormatOpenPMD::WriteToFile (
     m_OpenPMDPlotWriter->SetStep(output_iteration, prefix, file_min_digits, isBTD);
 
     // fields: only dumped for coarse level
+    // (gathered on the writer ranks one component at a time, if requested)
     m_OpenPMDPlotWriter->WriteOpenPMDFieldsAll(
-        varnames, mf, geom, output_levels, output_iteration, static_cast<amrex::Real>(time), isBTD, full_BTD_snapshot);
+        varnames, mf, geom, output_levels, output_iteration, static_cast<amrex::Real>(time), isBTD, full_BTD_snapshot,
+        m_single_precision_fields, WarpX::GetInstance().getIOAggregationFactor());
 
     // particles: all (reside only on locally finest level)
     m_OpenPMDPlotWriter->WriteOpenPMDParticles(
@@ -1,6 +1,7 @@
 #include "FlushFormatPlotfile.H"
 
 #include "Fields.H"
+#include "Diagnostics/IOAggregation.H"
 #include "Diagnostics/MultiDiagnostics.H"
 #include "Diagnostics/ParticleDiag/ParticleDiag.H"
 #include "Particles/Filter/FilterFunctors.H"
@@ -14,11 +15,14 @@
 #include "WarpX.H"
 
 #include <ablastr/fields/MultiFabRegister.H>
+#include <ablastr/warn_manager/WarnManager.H>
 
 #include <AMReX.H>
+#include <AMReX_AsyncOut.H>
 #include <AMReX_Box.H>
 #include <AMReX_BoxArray.H>
 #include <AMReX_Config.H>
+#include <AMReX_FArrayBox.H>
 #include <AMReX_GpuAllocators.H>
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_IntVect.H>
@@ -42,10 +46,12 @@
 
 #include <algorithm>
 #include <array>
+#include <condition_variable>
 #include <cstring>
 #include <fstream>
 #include <map>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include <vector>
 
@@ -55,6 +61,30 @@ using warpx::fields::FieldType;
 namespace
 {
     const std::string default_level_prefix {"Level_"};
+
+    // Number of plotfiles queued on the asynchronous output thread and not
+    // yet written to disk (shared by all the plotfile diagnostics)
+    std::mutex async_pending_mutex;
+    std::condition_variable async_pending_cv;
+    int async_pending_plotfiles = 0;
+}
+
+FlushFormatPlotfile::FlushFormatPlotfile ()
+{
+    const ParmParse pp_warpx("warpx");
+    utils::parser::queryWithParser(pp_warpx, "async_out_max_pending", m_async_out_max_pending);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_async_out_max_pending >= 0,
+        "warpx.async_out_max_pending must be non-negative");
+}
+
+void
+FlushFormatPlotfile::WaitForAsyncWrites (int max_pending)
+{
+    if (!amrex::AsyncOut::UseAsyncOut()) { return; }
+
+    WARPX_PROFILE("FlushFormatPlotfile::WaitForAsyncWrites()");
+    std::unique_lock<std::mutex> lock(async_pending_mutex);
+    async_pending_cv.wait(lock, [=]{ return async_pending_plotfiles <= max_pending; });
 }
 
 void
@@ -87,12 +117,39 @@ FlushFormatPlotfile::WriteToFile (
       }
     }
 
+    // With asynchronous output, the field and particle data are copied into
+    // buffers owned by the output thread. Bound the number of plotfiles in flight,
+    // to bound the memory used by these buffers.
+    const bool async_out = amrex::AsyncOut::UseAsyncOut();
+    if (async_out && m_async_out_max_pending > 0) {
+        WaitForAsyncWrites(m_async_out_max_pending - 1);
+    }
+
+    // Gather the data on the writer ranks, if requested
+    // (all components and levels at once, since WriteMultiLevelPlotfile writes them together)
+    const int aggregation_factor = warpx.getIOAggregationFactor();
+    amrex::Vector<amrex::MultiFab> mf_aggregated;
+    if (aggregation_factor > 1) {
+        mf_aggregated = warpx::diagnostics::AggregateMultiFabs(mf, aggregation_factor);
+    }
+    const amrex::Vector<amrex::MultiFab>& mf_out = (aggregation_factor > 1) ? mf_aggregated : mf;
+
     Vector<std::string> rfs;
     const VisMF::Header::Version current_version = VisMF::GetHeaderVersion();
     VisMF::SetHeaderVersion(amrex::VisMF::Header::Version_v1);
     if (plot_raw_fields) { rfs.emplace_back("raw_fields"); }
+    // the format of the FABs is only used by the synchronous writes
+    const FABio::Format current_format = FArrayBox::getFormat();
+    if (m_single_precision_fields) {
+        if (async_out) {
+            ablastr::warn_manager::WMRecordWarning("Diagnostics",
+                "The fields of the plotfiles are written in double precision with amrex.async_out = 1",
+                ablastr::warn_manager::WarnPriority::low);
+        }
+        FArrayBox::setFormat(FABio::FAB_NATIVE_32);
+    }
     amrex::WriteMultiLevelPlotfile(filename, nlev,
-                                   amrex::GetVecOfConstPtrs(mf),
+                                   amrex::GetVecOfConstPtrs(mf_out),
                                    varnames, geom,
                                    static_cast<Real>(time), iteration, warpx.refRatio(),
                                    "HyperCLaw-V1.1",
@@ -100,6 +157,7 @@ FlushFormatPlotfile::WriteToFile (
                                    "Cell",
                                    rfs
                                    );
+    FArrayBox::setFormat(current_format);
 
     WriteAllRawFields(plot_raw_fields, nlev, filename, plot_raw_fields_guards);
 
@@ -110,6 +168,22 @@ FlushFormatPlotfile::WriteToFile (
     WriteWarpXHeader(filename, geom);
 
     VisMF::SetHeaderVersion(current_version);
+
+    if (async_out) {
+        // The output thread processes its tasks in order: this one runs
+        // once all the data of this plotfile has been written
+        {
+            const std::lock_guard<std::mutex> lock(async_pending_mutex);
+            ++async_pending_plotfiles;
+        }
+        amrex::AsyncOut::Submit([]() {
+            {
+                const std::lock_guard<std::mutex> lock(async_pending_mutex);
+                --async_pending_plotfiles;
+            }
+            async_pending_cv.notify_all();
+        });
+    }
 }
 
 void
@@ -423,6 +497,9 @@ FlushFormatPlotfile::WriteParticles(const std::string& dir,
             tmp.copyParticles(*pinned_pc, true);
             particlesConvertUnits(ConvertDirection::WarpX_to_SI, &tmp, mass);
         }
+        // Gather the particles on the writer ranks, if requested
+        warpx::diagnostics::AggregateParticles(
+            tmp, WarpX::GetInstance().getIOAggregationFactor());
         // real_names contains a list of all particle attributes.
         // real_flags & int_flags are 1 or 0, whether quantity is dumped or not.
         tmp.WritePlotFile(
@@ -447,12 +524,21 @@ WriteRawMF ( const MultiFab& F, const DistributionMapping& dm,
                             filename, level_prefix, field_name);
     if (plot_guards) {
         // Dump original MultiFab F
-        VisMF::Write(F, prefix);
+        if (AsyncOut::UseAsyncOut()) {
+            VisMF::AsyncWrite(F, prefix);
+        } else {
+            VisMF::Write(F, prefix);
+        }
     } else {
         // Copy original MultiFab into one that does not have guard cells
         MultiFab tmpF( F.boxArray(), dm, F.nComp(), 0);
         MultiFab::Copy(tmpF, F, 0, 0, F.nComp(), 0);
-        VisMF::Write(tmpF, prefix);
+        if (AsyncOut::UseAsyncOut()) {
+            // Hand the copy over to the output thread
+            VisMF::AsyncWrite(std::move(tmpF), prefix);
+        } else {
+            VisMF::Write(tmpF, prefix);
+        }
     }
 }
 
@@ -0,0 +1,63 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "IOAggregation.H"
+
+#include <AMReX_BLProfiler.H>
+#include <AMReX_VisMF.H>
+
+#include <utility>
+
+
+namespace warpx::diagnostics
+{
+
+amrex::DistributionMapping
+WriterDistributionMapping (const amrex::DistributionMapping& dm, int factor)
+{
+    amrex::Vector<int> pmap = dm.ProcessorMap();
+    for (auto& rank : pmap) {
+        rank = (rank / factor) * factor;
+    }
+    return amrex::DistributionMapping(std::move(pmap));
+}
+
+amrex::MultiFab
+AggregateMultiFab (const amrex::MultiFab& mf, int factor, int icomp, int ncomp)
+{
+    BL_PROFILE("warpx::diagnostics::AggregateMultiFab");
+
+    if (ncomp < 0) { ncomp = mf.nComp() - icomp; }
+
+    amrex::MultiFab aggregated(mf.boxArray(),
+                               WriterDistributionMapping(mf.DistributionMap(), factor),
+                               ncomp, mf.nGrowVect());
+    aggregated.Redistribute(mf, icomp, 0, ncomp, mf.nGrowVect());
+    return aggregated;
+}
+
+amrex::Vector<amrex::MultiFab>
+AggregateMultiFabs (const amrex::Vector<amrex::MultiFab>& mf, int factor)
+{
+    amrex::Vector<amrex::MultiFab> aggregated;
+    aggregated.reserve(mf.size());
+    for (const auto& mf_lev : mf) {
+        aggregated.push_back(AggregateMultiFab(mf_lev, factor));
+    }
+    return aggregated;
+}
+
+void
+VisMFWriteAggregated (const amrex::MultiFab& mf, const std::string& name, int factor)
+{
+    if (factor > 1) {
+        amrex::VisMF::Write(AggregateMultiFab(mf, factor), name);
+    } else {
+        amrex::VisMF::Write(mf, name);
+    }
+}
+
+} // namespace warpx::diagnostics
@@ -661,28 +661,12 @@ void FieldProbe::WriteToFile (int step) const
         }
     }
 
-    // open file
-    std::ofstream ofs{m_path + m_rd_name + "." + m_extension,
-                        std::ofstream::out | std::ofstream::app};
-
     // loop over num valid particles and write
+    // (start at k = 1 since the particle id is not written to file)
+    amrex::Real const time = WarpX::GetInstance().gett_new(0);
     for (long int i = 0; i < m_valid_particles; i++)
     {
-        ofs << std::fixed << std::defaultfloat;
-        ofs << step + 1;
-        ofs << m_sep;
-        ofs << std::fixed << std::setprecision(14) << std::scientific;
-        // write time
-        ofs << WarpX::GetInstance().gett_new(0);
-
-        // start at k = 1 since the particle id is not written to file
-        for (int k = 1; k < noutputs; k++)
-        {
-            ofs << m_sep;
-            ofs << sorted_data[i * noutputs + k];
-        }
-        ofs << "\n";
-    } // end loop over data size
-    // close file
-    ofs.close();
+        AppendRow(step, time, &sorted_data[i * noutputs + 1], noutputs - 1);
+    }
+    CompleteOutput();
 }
@@ -0,0 +1,83 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "IonizationProductReallocations.H"
+
+#include "Particles/MultiParticleContainer.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/TextMsg.H"
+#include "WarpX.H"
+
+#include <AMReX_INT.H>
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_REAL.H>
+
+#include <fstream>
+
+using namespace amrex::literals;
+
+// constructor
+IonizationProductReallocations::IonizationProductReallocations (const std::string& rd_name)
+:ReducedDiags{rd_name}
+{
+    const auto& mypc = WarpX::GetInstance().GetPartContainer();
+    const auto species_names = mypc.GetSpeciesNames();
+
+    for (int i = 0; i < mypc.nSpecies(); ++i) {
+        if (mypc.GetParticleContainer(i).DoFieldIonization()) {
+            m_ionizable_species.push_back(i);
+        }
+    }
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        !m_ionizable_species.empty(),
+        "IonizationProductReallocations reduced diagnostics requires a species with field ionization");
+
+    // one number of reallocations per ionizable species
+    m_data.resize(m_ionizable_species.size(), 0.0_rt);
+
+    if (amrex::ParallelDescriptor::IOProcessor() && m_write_header) {
+        // open file
+        std::ofstream ofs{m_path + m_rd_name + "." + m_extension, std::ofstream::out};
+
+        // write header row
+        int c = 0;
+        ofs << "#";
+        ofs << "[" << c++ << "]step()";
+        ofs << m_sep;
+        ofs << "[" << c++ << "]time(s)";
+        for (const int i : m_ionizable_species) {
+            ofs << m_sep;
+            ofs << "[" << c++ << "]" << species_names[i] + "_product_reallocations()";
+        }
+
+        // close file
+        ofs << std::endl;
+        ofs.close();
+    }
+}
+// end constructor
+
+// function that gets the number of reallocations of the ionization products
+void IonizationProductReallocations::ComputeDiags (int step)
+{
+    // Check if diagnostic should be done
+    if (!m_intervals.contains(step+1)) { return; }
+
+    const auto& mypc = WarpX::GetInstance().GetPartContainer();
+
+    std::vector<amrex::Long> num_reallocations;
+    for (const int i : m_ionizable_species) {
+        num_reallocations.push_back(mypc.GetParticleContainer(i).NumIonizationProductReallocations());
+    }
+    amrex::ParallelDescriptor::ReduceLongSum(num_reallocations.data(),
+        static_cast<int>(num_reallocations.size()), amrex::ParallelDescriptor::IOProcessorNumber());
+
+    for (std::size_t i = 0; i < num_reallocations.size(); ++i) {
+        m_data[i] = static_cast<amrex::Real>(num_reallocations[i]);
+    }
+}
+// end IonizationProductReallocations::ComputeDiags
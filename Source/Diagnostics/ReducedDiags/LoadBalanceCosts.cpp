@@ -34,6 +34,7 @@
 #include <iomanip>
 #include <istream>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <utility>
 
@@ -72,6 +73,9 @@ namespace
 LoadBalanceCosts::LoadBalanceCosts (const std::string& rd_name)
     : ReducedDiags{rd_name}
 {
+    // the number of columns changes with the number of boxes
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_format == "text",
+        "LoadBalanceCosts only supports the text format");
 }
 
 // function that gathers costs
@@ -250,9 +254,8 @@ void LoadBalanceCosts::ComputeDiags (int step)
 // write to file function for cost
 void LoadBalanceCosts::WriteToFile (int step) const
 {
-    // open file
-    std::ofstream ofs{m_path + m_rd_name + "." + m_extension,
-            std::ofstream::out | std::ofstream::app};
+    // format the row (buffered, and written every flush_interval outputs)
+    std::ostringstream ofs;
 
     // write step
     ofs << step+1 << m_sep;
@@ -281,8 +284,8 @@ void LoadBalanceCosts::WriteToFile (int step) const
     // end line
     ofs << "\n";
 
-    // close file
-    ofs.close();
+    AppendLine(ofs.str());
+    CompleteOutput();
 
     // get a reference to WarpX instance
     auto& warpx = WarpX::GetInstance();
@@ -292,6 +295,9 @@ void LoadBalanceCosts::WriteToFile (int step) const
     // final step is a special case, fill jagged array with NaN
     if (m_intervals.nextContains(step+1) > warpx.maxStep())
     {
+        // the buffered rows must be in the file before it is rewritten
+        FlushBuffer();
+
         // open tmp file to copy data
         const std::string fileTmpName = m_path + m_rd_name + ".tmp." + m_extension;
         std::ofstream ofstmp(fileTmpName, std::ofstream::out);
@@ -15,6 +15,7 @@
 #include "FieldMomentum.H"
 #include "FieldProbe.H"
 #include "FieldReduction.H"
+#include "IonizationProductReallocations.H"
 #include "LoadBalanceCosts.H"
 #include "LoadBalanceEfficiency.H"
 #include "ParticleEnergy.H"
@@ -23,7 +24,9 @@
 #include "ParticleHistogram2D.H"
 #include "ParticleMomentum.H"
 #include "ParticleNumber.H"
+#include "PoissonSolverIterations.H"
 #include "RhoMaximum.H"
+#include "SpectralTransformError.H"
 #include "Timestep.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXProfilerWrapper.H"
@@ -68,9 +71,12 @@ MultiReducedDiags::MultiReducedDiags ()
             {"FieldMomentum",         [](CS s){return std::make_unique<FieldMomentum>(s);}},
             {"FieldProbe",            [](CS s){return std::make_unique<FieldProbe>(s);}},
             {"FieldReduction",        [](CS s){return std::make_unique<FieldReduction>(s);}},
+            {"IonizationProductReallocations",[](CS s){return std::make_unique<IonizationProductReallocations>(s);}},
             {"LoadBalanceCosts",      [](CS s){return std::make_unique<LoadBalanceCosts>(s);}},
             {"LoadBalanceEfficiency", [](CS s){return std::make_unique<LoadBalanceEfficiency>(s);}},
+            {"PoissonSolverIterations",[](CS s){return std::make_unique<PoissonSolverIterations>(s);}},
             {"RhoMaximum",            [](CS s){return std::make_unique<RhoMaximum>(s);}},
+            {"SpectralTransformError",[](CS s){return std::make_unique<SpectralTransformError>(s);}},
             {"Timestep",              [](CS s){return std::make_unique<Timestep>(s);}}
     };
     // loop over all reduced diags and fill m_multi_rd with requested reduced diags
@@ -124,6 +130,17 @@ void MultiReducedDiags::ComputeDiags (int step)
 }
 // end void MultiReducedDiags::ComputeDiags
 
+// function to check if any reduced diags is computed at this step
+bool MultiReducedDiags::DoComputeDiags (int step) const
+{
+    for (const auto& rd : m_multi_rd)
+    {
+        if (rd->m_intervals.contains(step+1)) { return true; }
+    }
+    return false;
+}
+// end bool MultiReducedDiags::DoComputeDiags
+
 // function to write data
 void MultiReducedDiags::WriteToFile (int step)
 {
@@ -142,3 +159,12 @@ void MultiReducedDiags::WriteToFile (int step)
     // end loop over all reduced diags
 }
 // end void MultiReducedDiags::WriteToFile
+
+// function to write the buffered data
+void MultiReducedDiags::FlushBuffers ()
+{
+    // Only the I/O rank does
+    if ( !ParallelDescriptor::IOProcessor() ) { return; }
+
+    for (const auto& rd : m_multi_rd) { rd->FlushBuffer(); }
+}
@@ -40,6 +40,7 @@
 
 #include <algorithm>
 #include <array>
+#include <cstddef>
 #include <limits>
 #include <memory>
 #include <ostream>
@@ -57,6 +58,9 @@ using namespace amrex;
 ParticleHistogram2D::ParticleHistogram2D (const std::string& rd_name)
         : ReducedDiags{rd_name}
 {
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_format == "text",
+        "ParticleHistogram2D is written with openPMD: the format parameter does not apply");
+
     ParmParse pp_rd_name(rd_name);
 
     pp_rd_name.query("openpmd_backend", m_openpmd_backend);
@@ -261,6 +265,37 @@ void ParticleHistogram2D::WriteToFile (int step) const
     // only IO processor writes
     if ( !ParallelDescriptor::IOProcessor() ) { return; }
 
+    // Get time at level 0
+    auto & warpx = WarpX::GetInstance();
+    auto const time = warpx.gett_new(0);
+
+    // the histogram is written every flush_interval outputs
+    auto const& h_table_data = m_h_data_2D.table();
+    auto const npts = static_cast<std::size_t>(m_bin_num_ord) * static_cast<std::size_t>(m_bin_num_abs);
+    m_buffered_histograms.push_back({step, time, std::vector<amrex::Real>(h_table_data.p, h_table_data.p + npts)});
+    CompleteOutput();
+#else
+    amrex::ignore_unused(step);
+    WARPX_ABORT_WITH_MESSAGE("ParticleHistogram2D: Needs openPMD-api compiled into WarpX, but was not found!");
+#endif
+}
+
+void ParticleHistogram2D::FlushBuffer () const
+{
+    for (auto const& histogram : m_buffered_histograms) {
+        WriteHistogram(histogram);
+    }
+    m_buffered_histograms.clear();
+
+    // reset the number of buffered outputs
+    ReducedDiags::FlushBuffer();
+}
+
+void ParticleHistogram2D::WriteHistogram (const BufferedHistogram& histogram) const
+{
+#ifdef WARPX_USE_OPENPMD
+    int const step = histogram.step;
+
     // TODO: support different filename templates
     std::string filename = "openpmd";
     // TODO: support also group-based encoding
@@ -304,14 +339,10 @@ void ParticleHistogram2D::WriteToFile (int step) const
 
     // UNIT DIMENSION IS NOT SET ON THE VALUES
 
-    // Get time at level 0
-    auto & warpx = WarpX::GetInstance();
-    auto const time = warpx.gett_new(0);
-    i.setTime(time);
+    i.setTime(histogram.time);
 
-    auto const& h_table_data = m_h_data_2D.table();
     data.storeChunkRaw(
-            h_table_data.p,
+            histogram.data.data(),
             {0, 0},
             {static_cast<unsigned long>(m_bin_num_ord), static_cast<unsigned long>(m_bin_num_abs)});
 
@@ -319,7 +350,6 @@ void ParticleHistogram2D::WriteToFile (int step) const
     i.close();
     series.close();
 #else
-    amrex::ignore_unused(step);
-    WARPX_ABORT_WITH_MESSAGE("ParticleHistogram2D: Needs openPMD-api compiled into WarpX, but was not found!");
+    amrex::ignore_unused(histogram);
 #endif
 }
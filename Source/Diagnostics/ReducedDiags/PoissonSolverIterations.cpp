@@ -0,0 +1,66 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "PoissonSolverIterations.H"
+
+#include "FieldSolver/ElectrostaticSolvers/ElectrostaticSolver.H"
+#include "Utils/TextMsg.H"
+#include "WarpX.H"
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_REAL.H>
+
+#include <fstream>
+
+using namespace amrex::literals;
+
+// constructor
+PoissonSolverIterations::PoissonSolverIterations (const std::string& rd_name)
+:ReducedDiags{rd_name}
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        WarpX::electrostatic_solver_id != ElectrostaticSolverAlgo::None,
+        "PoissonSolverIterations reduced diagnostics requires an electrostatic solver");
+
+    // number of MLMG iterations and relative tolerance
+    m_data.resize(2, 0.0_rt);
+
+    if (amrex::ParallelDescriptor::IOProcessor() && m_write_header) {
+        // open file
+        std::ofstream ofs{m_path + m_rd_name + "." + m_extension, std::ofstream::out};
+
+        // write header row
+        int c = 0;
+        ofs << "#";
+        ofs << "[" << c++ << "]step()";
+        ofs << m_sep;
+        ofs << "[" << c++ << "]time(s)";
+        ofs << m_sep;
+        ofs << "[" << c++ << "]mlmg_iterations()";
+        ofs << m_sep;
+        ofs << "[" << c++ << "]required_precision()";
+
+        // close file
+        ofs << std::endl;
+        ofs.close();
+    }
+}
+// end constructor
+
+// function that gets the iteration count of the last Poisson solve
+void PoissonSolverIterations::ComputeDiags (int step)
+{
+    // Check if diagnostic should be done
+    if (!m_intervals.contains(step+1)) { return; }
+
+    auto& warpx = WarpX::GetInstance();
+    const auto& es_solver = warpx.GetElectrostaticSolver();
+
+    m_data[0] = static_cast<amrex::Real>(es_solver.num_mlmg_iters);
+    m_data[1] = es_solver.last_required_precision;
+}
+// end PoissonSolverIterations::ComputeDiags
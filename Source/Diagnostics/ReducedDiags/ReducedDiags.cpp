@@ -19,6 +19,8 @@
 
 #include <fstream>
 #include <iomanip>
+#include <sstream>
+#include <string>
 
 using namespace amrex;
 
@@ -36,6 +38,16 @@ m_rd_name{rd_name}
     // read extension
     pp_rd_name.query("extension", m_extension);
 
+    // read output format and buffering
+    pp_rd_name.query("format", m_format);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_format == "text" || m_format == "binary",
+        m_rd_name + ".format must be either text or binary");
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_format == "text" || m_extension != "bin",
+        m_rd_name + ".extension cannot be bin with the binary format");
+    utils::parser::queryWithParser(pp_rd_name, "flush_interval", m_flush_interval);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_flush_interval >= 1,
+        m_rd_name + ".flush_interval must be at least 1");
+
     // check if it is a restart run
     std::string restart_chkfile;
     const ParmParse pp_amr("amr");
@@ -57,6 +69,18 @@ m_rd_name{rd_name}
             std::ofstream ofs{rd_full_file_name, std::ios::trunc};
             ofs.close();
         }
+
+        // replace / create binary output file
+        if (m_format == "binary")
+        {
+            const std::string rd_binary_file_name = m_path + m_rd_name + ".bin";
+            m_write_binary_header = IsNotRestart || !amrex::FileExists(rd_binary_file_name);
+            if (m_write_binary_header)
+            {
+                std::ofstream ofs{rd_binary_file_name, std::ios::trunc | std::ios::binary};
+                ofs.close();
+            }
+        }
     }
 
     // read reduced diags intervals
@@ -100,30 +124,94 @@ void ReducedDiags::BackwardCompatibility () const
 // write to file function
 void ReducedDiags::WriteToFile (int step) const
 {
-    // open file
-    std::ofstream ofs{m_path + m_rd_name + "." + m_extension,
-        std::ofstream::out | std::ofstream::app};
+    AppendRow(step, WarpX::GetInstance().gett_new(0), m_data.data(), static_cast<int>(m_data.size()));
+    CompleteOutput();
+}
+// end ReducedDiags::WriteToFile
 
-    // write step
-    ofs << step+1;
+void ReducedDiags::AppendRow (int step, amrex::Real time, const amrex::Real* data, int ndata) const
+{
+    if (m_format == "binary")
+    {
+        // the number of columns is written in the header of the file
+        if (m_binary_ncols == 0) { m_binary_ncols = ndata + 2; }
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(ndata + 2 == m_binary_ncols,
+            "The number of columns of the binary reduced diagnostics " + m_rd_name + " cannot change");
+
+        m_binary_buffer.push_back(static_cast<double>(step+1));
+        m_binary_buffer.push_back(static_cast<double>(time));
+        for (int i = 0; i < ndata; ++i) { m_binary_buffer.push_back(static_cast<double>(data[i])); }
+    }
+    else
+    {
+        std::ostringstream ss;
 
-    ofs << m_sep;
+        // write step
+        ss << step+1;
 
-    // set precision
-    ofs << std::fixed << std::setprecision(m_precision) << std::scientific;
+        ss << m_sep;
 
-    // write time
-    ofs << WarpX::GetInstance().gett_new(0);
+        // set precision
+        ss << std::fixed << std::setprecision(m_precision) << std::scientific;
 
-    // loop over data size and write
-    for (const auto& item : m_data) { ofs << m_sep << item; }
+        // write time
+        ss << time;
 
-    // end loop over data size
+        // loop over data size and write
+        for (int i = 0; i < ndata; ++i) { ss << m_sep << data[i]; }
 
-    // end line
-    ofs << "\n";
+        // end line
+        ss << "\n";
 
-    // close file
-    ofs.close();
+        m_text_buffer += ss.str();
+    }
+}
+
+void ReducedDiags::AppendLine (const std::string& line) const
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_format == "text",
+        "The rows of the reduced diagnostics " + m_rd_name + " can only be written in text format");
+    m_text_buffer += line;
+}
+
+void ReducedDiags::CompleteOutput () const
+{
+    ++m_num_buffered_outputs;
+    if (m_num_buffered_outputs >= m_flush_interval) { FlushBuffer(); }
+}
+
+void ReducedDiags::FlushBuffer () const
+{
+    m_num_buffered_outputs = 0;
+    if (m_text_buffer.empty() && m_binary_buffer.empty()) { return; }
+
+    if (m_format == "binary")
+    {
+        std::ofstream ofs{m_path + m_rd_name + ".bin",
+            std::ofstream::out | std::ofstream::app | std::ofstream::binary};
+
+        if (m_write_binary_header)
+        {
+            // the column names are taken from the header of the text file
+            std::string header_line;
+            std::ifstream ifs{m_path + m_rd_name + "." + m_extension};
+            std::getline(ifs, header_line);
+
+            ofs << "WarpX reduced diagnostics binary 1\n"
+                << m_binary_ncols << "\n"
+                << header_line << "\n";
+            m_write_binary_header = false;
+        }
+
+        ofs.write(reinterpret_cast<const char*>(m_binary_buffer.data()),
+                  static_cast<std::streamsize>(m_binary_buffer.size() * sizeof(double)));
+        m_binary_buffer.clear();
+    }
+    else
+    {
+        std::ofstream ofs{m_path + m_rd_name + "." + m_extension,
+            std::ofstream::out | std::ofstream::app};
+        ofs << m_text_buffer;
+        m_text_buffer.clear();
+    }
 }
-// end ReducedDiags::WriteToFile
@@ -0,0 +1,118 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "SpectralTransformError.H"
+
+#include "Fields.H"
+#include "Utils/TextMsg.H"
+#include "Utils/WarpXAlgorithmSelection.H"
+#include "WarpX.H"
+
+#ifdef WARPX_USE_FFT
+#   include "FieldSolver/SpectralSolver/SpectralSolver.H"
+#endif
+
+#include <ablastr/fields/MultiFabRegister.H>
+
+#include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParmParse.H>
+#include <AMReX_REAL.H>
+
+#include <fstream>
+#include <string>
+
+using namespace amrex::literals;
+using warpx::fields::FieldType;
+
+// constructor
+SpectralTransformError::SpectralTransformError (const std::string& rd_name)
+: ReducedDiags{rd_name}
+{
+#if !defined(WARPX_USE_FFT) || defined(WARPX_DIM_RZ)
+    WARPX_ABORT_WITH_MESSAGE(
+        "SpectralTransformError reduced diagnostics requires the PSATD solver "
+        "in Cartesian geometry (compile with WarpX_FFT=ON).");
+#endif
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        WarpX::electromagnetic_solver_id == ElectromagneticSolverAlgo::PSATD,
+        "SpectralTransformError reduced diagnostics requires algo.maxwell_solver = psatd.");
+
+    // read number of levels
+    int nLevel = 0;
+    const amrex::ParmParse pp_amr("amr");
+    pp_amr.query("max_level", nLevel);
+    nLevel += 1;
+
+    constexpr int noutputs = 6; // Ex, Ey, Ez, Bx, By, Bz
+    // resize data array
+    m_data.resize(noutputs*nLevel, 0.0_rt);
+
+    if (amrex::ParallelDescriptor::IOProcessor())
+    {
+        if ( m_write_header )
+        {
+            // open file
+            std::ofstream ofs{m_path + m_rd_name + "." + m_extension, std::ofstream::out};
+            // write header row
+            int c = 0;
+            ofs << "#";
+            ofs << "[" << c++ << "]step()";
+            ofs << m_sep;
+            ofs << "[" << c++ << "]time(s)";
+            for (int lev = 0; lev < nLevel; ++lev)
+            {
+                for (const auto* comp : {"Ex", "Ey", "Ez", "Bx", "By", "Bz"})
+                {
+                    ofs << m_sep;
+                    ofs << "[" << c++ << "]err_" << comp << "_lev" + std::to_string(lev) + "()";
+                }
+            }
+            ofs << "\n";
+            // close file
+            ofs.close();
+        }
+    }
+}
+// end constructor
+
+// function that computes the round-trip error of the Fourier transforms
+void SpectralTransformError::ComputeDiags (int step)
+{
+    // Judge if the diags should be done
+    if (!m_intervals.contains(step+1)) { return; }
+
+#if defined(WARPX_USE_FFT) && !defined(WARPX_DIM_RZ)
+    // get a reference to WarpX instance
+    auto & warpx = WarpX::GetInstance();
+
+    // get number of level
+    const auto nLevel = warpx.finestLevel() + 1;
+
+    using ablastr::fields::Direction;
+
+    constexpr int noutputs = 6; // Ex, Ey, Ez, Bx, By, Bz
+
+    // loop over refinement levels
+    for (int lev = 0; lev < nLevel; ++lev)
+    {
+        auto& solver = warpx.get_spectral_solver_fp(lev);
+
+        for (int idir = 0; idir < 3; ++idir)
+        {
+            const amrex::MultiFab& E = *warpx.m_fields.get(FieldType::Efield_fp, Direction{idir}, lev);
+            const amrex::MultiFab& B = *warpx.m_fields.get(FieldType::Bfield_fp, Direction{idir}, lev);
+            m_data[lev*noutputs + idir] = solver.TransformRoundTripError(lev, E);
+            m_data[lev*noutputs + 3 + idir] = solver.TransformRoundTripError(lev, B);
+        }
+    }
+    // end loop over refinement levels
+#endif
+
+    /* m_data now contains up-to-date values for:
+     *  [err(Ex), err(Ey), err(Ez), err(Bx), err(By), err(Bz)] */
+}
+// end void SpectralTransformError::ComputeDiags
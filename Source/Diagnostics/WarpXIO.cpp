@@ -14,6 +14,8 @@
 #include "EmbeddedBoundary/Enabled.H"
 #include "Fields.H"
 #include "FieldIO.H"
+#include "Diagnostics/FlushFormats/FlushFormatCheckpoint.H"
+#include "Diagnostics/MemoryCheckpoint.H"
 #include "Particles/MultiParticleContainer.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXProfilerWrapper.H"
@@ -21,18 +23,23 @@
 #include "Diagnostics/MultiDiagnostics.H"
 
 #include <ablastr/utils/Communication.H>
+#include <ablastr/utils/timer/Timer.H>
 #include <ablastr/utils/text/StreamUtils.H>
 
 #ifdef AMREX_USE_SENSEI_INSITU
 #   include <AMReX_AmrMeshInSituBridge.H>
 #endif
+#include <AMReX_Arena.H>
 #include <AMReX_BoxArray.H>
 #include <AMReX_Config.H>
 #include <AMReX_DistributionMapping.H>
 #include <AMReX_Geometry.H>
+#include <AMReX_GpuAllocators.H>
+#include <AMReX_INT.H>
 #include <AMReX_IntVect.H>
 #include <AMReX_MultiFab.H>
 #include <AMReX_ParallelDescriptor.H>
+#include <AMReX_ParticleTransformation.H>
 #include <AMReX_PlotFileUtil.H>
 #include <AMReX_Print.H>
 #include <AMReX_REAL.H>
@@ -40,9 +47,13 @@
 #include <AMReX_Vector.H>
 #include <AMReX_VisMF.H>
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
 #include <istream>
 #include <memory>
+#include <set>
+#include <sstream>
 #include <string>
 #include <utility>
 
@@ -51,6 +62,75 @@ using namespace amrex;
 namespace
 {
     const std::string level_prefix {"Level_"};
+
+    using PinnedTile = PinnedMemoryParticleContainer::ParticleTileType;
+
+    /** Partner rank of this MPI rank for the mirrored in-memory checkpoints,
+     *  or -1 for the last rank of an odd number of ranks */
+    int MemoryCheckpointPartner ()
+    {
+        int const partner = ParallelDescriptor::MyProc() ^ 1;
+        return (partner < ParallelDescriptor::NProcs()) ? partner : -1;
+    }
+
+    /** Distribution mapping in which each box is owned by the partner rank of its owner */
+    amrex::DistributionMapping PartnerDistributionMapping (amrex::DistributionMapping const& dm)
+    {
+        amrex::Vector<int> pmap = dm.ProcessorMap();
+        int const nprocs = ParallelDescriptor::NProcs();
+        for (auto& proc : pmap) {
+            if ((proc ^ 1) < nprocs) { proc ^= 1; }
+        }
+        return amrex::DistributionMapping{pmap};
+    }
+
+    /** Exchange n_send elements for n_recv elements with the partner rank.
+     *  The rank with the lower number sends first, so that the blocking calls match. */
+    template <typename T>
+    void SendRecvWithPartner (T const* send, amrex::Long n_send, T* recv, amrex::Long n_recv,
+                              int partner, int tag)
+    {
+        if (ParallelDescriptor::MyProc() < partner) {
+            ParallelDescriptor::Send(send, static_cast<std::size_t>(n_send), partner, tag);
+            ParallelDescriptor::Recv(recv, static_cast<std::size_t>(n_recv), partner, tag);
+        } else {
+            ParallelDescriptor::Recv(recv, static_cast<std::size_t>(n_recv), partner, tag);
+            ParallelDescriptor::Send(send, static_cast<std::size_t>(n_send), partner, tag);
+        }
+    }
+
+    /** Send the particles of a tile to the partner rank, and receive its particles */
+    void ExchangeTileWithPartner (PinnedTile const& send, PinnedTile& recv, int partner)
+    {
+        amrex::Long const np_send = send.numParticles();
+        amrex::Long np_recv = 0;
+        SendRecvWithPartner(&np_send, 1, &np_recv, 1, partner, 0);
+        recv.resize(np_recv);
+
+        auto const& send_soa = send.GetStructOfArrays();
+        auto& recv_soa = recv.GetStructOfArrays();
+        SendRecvWithPartner(send_soa.GetIdCPUData().data(), np_send,
+                            recv_soa.GetIdCPUData().data(), np_recv, partner, 1);
+        for (int icomp = 0; icomp < send_soa.NumRealComps(); ++icomp) {
+            SendRecvWithPartner(send_soa.GetRealData(icomp).data(), np_send,
+                                recv_soa.GetRealData(icomp).data(), np_recv, partner, 2);
+        }
+        for (int icomp = 0; icomp < send_soa.NumIntComps(); ++icomp) {
+            SendRecvWithPartner(send_soa.GetIntData(icomp).data(), np_send,
+                                recv_soa.GetIntData(icomp).data(), np_recv, partner, 3);
+        }
+    }
+
+    /** Append the particles of src at the end of dst */
+    template <typename DstTile, typename SrcTile>
+    void AppendParticles (DstTile& dst, SrcTile const& src)
+    {
+        auto const old_np = dst.numParticles();
+        auto const np = src.numParticles();
+        if (np == 0) { return; }
+        dst.resize(old_np + np);
+        amrex::copyParticles(dst, src, 0, old_np, np);
+    }
 }
 
 amrex::DistributionMapping
@@ -74,6 +154,12 @@ WarpX::GetRestartDMap (const std::string& chkfile, const amrex::BoxArray& ba, in
     int nprocs_in_checkpoint;
     DMFile >> nprocs_in_checkpoint;
     if (nprocs_in_checkpoint != ParallelDescriptor::NProcs()) {
+        // The data is read from the byte offsets stored in the headers, and particles
+        // are redistributed after reading, so any distribution mapping can be used.
+        amrex::Print() << Utils::TextMsg::Info(
+            "Checkpoint was written with " + std::to_string(nprocs_in_checkpoint)
+            + " MPI ranks and is read with " + std::to_string(ParallelDescriptor::NProcs())
+            + " MPI ranks: level " + std::to_string(lev) + " is redistributed");
         return amrex::DistributionMapping{ba, ParallelDescriptor::NProcs()};
     }
 
@@ -97,6 +183,11 @@ WarpX::InitFromCheckpoint ()
     amrex::Print()<< Utils::TextMsg::Info(
         "restart from checkpoint " + restart_chkfile);
 
+    auto timer_header = ablastr::utils::timer::Timer{};
+    auto timer_fields = ablastr::utils::timer::Timer{};
+    auto timer_particles = ablastr::utils::timer::Timer{};
+    timer_header.record_start_time();
+
     // Header
     {
         const std::string File(restart_chkfile + "/WarpXHeader");
@@ -277,6 +368,65 @@ WarpX::InitFromCheckpoint ()
         }
     }
 
+    // An incremental checkpoint does not contain the static fields: they are read from
+    // the last full checkpoint, which is located in the same directory.
+    std::string base_chkfile;
+    std::set<std::string> entries_from_base;
+    const std::string base_filename = restart_chkfile + "/" + FlushFormatCheckpoint::incremental_base_filename;
+    if (amrex::FileExists(base_filename)) {
+        Vector<char> fileCharPtr;
+        ParallelDescriptor::ReadAndBcastFile(base_filename, fileCharPtr);
+        const std::string fileCharPtrString(fileCharPtr.dataPtr());
+        std::istringstream is(fileCharPtrString, std::istringstream::in);
+        is.exceptions(std::ios_base::failbit | std::ios_base::badbit);
+
+        std::string base_name;
+        std::getline(is, base_name);
+        std::string chkfile = restart_chkfile;
+        while (!chkfile.empty() && chkfile.back() == '/') { chkfile.pop_back(); }
+        const auto pos = chkfile.find_last_of('/');
+        base_chkfile = (pos == std::string::npos) ? base_name : chkfile.substr(0, pos+1) + base_name;
+
+        int n_entries;
+        is >> n_entries;
+        ablastr::utils::text::goto_next_line(is);
+        for (int i = 0; i < n_entries; ++i) {
+            std::string entry;
+            std::getline(is, entry);
+            entries_from_base.insert(entry);
+        }
+        amrex::Print() << Utils::TextMsg::Info(
+            "incremental checkpoint: " + std::to_string(n_entries)
+            + " static fields are read from " + base_chkfile);
+    }
+
+    auto const read_mf = [&] (amrex::MultiFab& mf, int lev, const std::string& name)
+    {
+        const bool from_base = entries_from_base.count("field " + std::to_string(lev) + " " + name) > 0;
+        if (!from_base) {
+            VisMF::Read(mf, amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, name));
+            return;
+        }
+        // The grids may have changed since the full checkpoint was written (e.g., by regridding):
+        // VisMF::Read requires the same BoxArray, otherwise the data is copied from a temporary.
+        const std::string base_mf_name = amrex::MultiFabFileFullPrefix(lev, base_chkfile, level_prefix, name);
+        const VisMF base_vismf(base_mf_name);
+        if (base_vismf.boxArray() == mf.boxArray()) {
+            VisMF::Read(mf, base_mf_name);
+        } else {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                base_vismf.boxArray().ixType() == mf.ixType() && base_vismf.nComp() == mf.nComp(),
+                "incremental checkpoint: " + name + " in " + base_chkfile
+                + " does not match the field of the simulation");
+            amrex::MultiFab base_mf;
+            VisMF::Read(base_mf, base_mf_name);
+            mf.ParallelCopy(base_mf, 0, 0, mf.nComp(), amrex::IntVect(0), mf.nGrowVect(), Geom(lev).periodicity());
+        }
+    };
+
+    timer_header.record_stop_time();
+    timer_fields.record_start_time();
+
     const int nlevs = finestLevel()+1;
 
     // Initialize the field data
@@ -299,86 +449,56 @@ WarpX::InitFromCheckpoint ()
             }
         }
 
-        VisMF::Read(*m_fields.get(FieldType::Efield_fp, Direction{0}, lev),
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_fp"));
-        VisMF::Read(*m_fields.get(FieldType::Efield_fp, Direction{1}, lev),
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_fp"));
-        VisMF::Read(*m_fields.get(FieldType::Efield_fp, Direction{2}, lev),
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_fp"));
+        read_mf(*m_fields.get(FieldType::Efield_fp, Direction{0}, lev), lev, "Ex_fp");
+        read_mf(*m_fields.get(FieldType::Efield_fp, Direction{1}, lev), lev, "Ey_fp");
+        read_mf(*m_fields.get(FieldType::Efield_fp, Direction{2}, lev), lev, "Ez_fp");
 
-        VisMF::Read(*m_fields.get(FieldType::Bfield_fp, Direction{0}, lev),
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_fp"));
-        VisMF::Read(*m_fields.get(FieldType::Bfield_fp, Direction{1}, lev),
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_fp"));
-        VisMF::Read(*m_fields.get(FieldType::Bfield_fp, Direction{2}, lev),
-                    amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_fp"));
+        read_mf(*m_fields.get(FieldType::Bfield_fp, Direction{0}, lev), lev, "Bx_fp");
+        read_mf(*m_fields.get(FieldType::Bfield_fp, Direction{1}, lev), lev, "By_fp");
+        read_mf(*m_fields.get(FieldType::Bfield_fp, Direction{2}, lev), lev, "Bz_fp");
 
         if (WarpX::fft_do_time_averaging)
         {
-            VisMF::Read(*m_fields.get(FieldType::Efield_avg_fp, Direction{0}, lev),
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_avg_fp"));
-            VisMF::Read(*m_fields.get(FieldType::Efield_avg_fp, Direction{1}, lev),
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_avg_fp"));
-            VisMF::Read(*m_fields.get(FieldType::Efield_avg_fp, Direction{2}, lev),
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_avg_fp"));
-
-            VisMF::Read(*m_fields.get(FieldType::Bfield_avg_fp, Direction{0}, lev),
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_avg_fp"));
-            VisMF::Read(*m_fields.get(FieldType::Bfield_avg_fp, Direction{1}, lev),
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_avg_fp"));
-            VisMF::Read(*m_fields.get(FieldType::Bfield_avg_fp, Direction{2}, lev),
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_avg_fp"));
+            read_mf(*m_fields.get(FieldType::Efield_avg_fp, Direction{0}, lev), lev, "Ex_avg_fp");
+            read_mf(*m_fields.get(FieldType::Efield_avg_fp, Direction{1}, lev), lev, "Ey_avg_fp");
+            read_mf(*m_fields.get(FieldType::Efield_avg_fp, Direction{2}, lev), lev, "Ez_avg_fp");
+
+            read_mf(*m_fields.get(FieldType::Bfield_avg_fp, Direction{0}, lev), lev, "Bx_avg_fp");
+            read_mf(*m_fields.get(FieldType::Bfield_avg_fp, Direction{1}, lev), lev, "By_avg_fp");
+            read_mf(*m_fields.get(FieldType::Bfield_avg_fp, Direction{2}, lev), lev, "Bz_avg_fp");
         }
 
         if (is_synchronized) {
-            VisMF::Read(*m_fields.get(FieldType::current_fp, Direction{0}, lev),
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jx_fp"));
-            VisMF::Read(*m_fields.get(FieldType::current_fp, Direction{1}, lev),
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jy_fp"));
-            VisMF::Read(*m_fields.get(FieldType::current_fp, Direction{2}, lev),
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jz_fp"));
+            read_mf(*m_fields.get(FieldType::current_fp, Direction{0}, lev), lev, "jx_fp");
+            read_mf(*m_fields.get(FieldType::current_fp, Direction{1}, lev), lev, "jy_fp");
+            read_mf(*m_fields.get(FieldType::current_fp, Direction{2}, lev), lev, "jz_fp");
         }
 
         if (lev > 0)
         {
-            VisMF::Read(*m_fields.get(FieldType::Efield_cp, Direction{0}, lev),
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_cp"));
-            VisMF::Read(*m_fields.get(FieldType::Efield_cp, Direction{1}, lev),
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_cp"));
-            VisMF::Read(*m_fields.get(FieldType::Efield_cp, Direction{2}, lev),
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_cp"));
-
-            VisMF::Read(*m_fields.get(FieldType::Bfield_cp, Direction{0}, lev),
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_cp"));
-            VisMF::Read(*m_fields.get(FieldType::Bfield_cp, Direction{1}, lev),
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_cp"));
-            VisMF::Read(*m_fields.get(FieldType::Bfield_cp, Direction{2}, lev),
-                        amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_cp"));
+            read_mf(*m_fields.get(FieldType::Efield_cp, Direction{0}, lev), lev, "Ex_cp");
+            read_mf(*m_fields.get(FieldType::Efield_cp, Direction{1}, lev), lev, "Ey_cp");
+            read_mf(*m_fields.get(FieldType::Efield_cp, Direction{2}, lev), lev, "Ez_cp");
+
+            read_mf(*m_fields.get(FieldType::Bfield_cp, Direction{0}, lev), lev, "Bx_cp");
+            read_mf(*m_fields.get(FieldType::Bfield_cp, Direction{1}, lev), lev, "By_cp");
+            read_mf(*m_fields.get(FieldType::Bfield_cp, Direction{2}, lev), lev, "Bz_cp");
 
             if (WarpX::fft_do_time_averaging)
             {
-                VisMF::Read(*m_fields.get(FieldType::Efield_avg_cp, Direction{0}, lev),
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ex_avg_cp"));
-                VisMF::Read(*m_fields.get(FieldType::Efield_avg_cp, Direction{1}, lev),
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ey_avg_cp"));
-                VisMF::Read(*m_fields.get(FieldType::Efield_avg_cp, Direction{2}, lev),
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Ez_avg_cp"));
-
-                VisMF::Read(*m_fields.get(FieldType::Bfield_avg_cp, Direction{0}, lev),
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bx_avg_cp"));
-                VisMF::Read(*m_fields.get(FieldType::Bfield_avg_cp, Direction{1}, lev),
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "By_avg_cp"));
-                VisMF::Read(*m_fields.get(FieldType::Bfield_avg_cp, Direction{2}, lev),
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "Bz_avg_cp"));
+                read_mf(*m_fields.get(FieldType::Efield_avg_cp, Direction{0}, lev), lev, "Ex_avg_cp");
+                read_mf(*m_fields.get(FieldType::Efield_avg_cp, Direction{1}, lev), lev, "Ey_avg_cp");
+                read_mf(*m_fields.get(FieldType::Efield_avg_cp, Direction{2}, lev), lev, "Ez_avg_cp");
+
+                read_mf(*m_fields.get(FieldType::Bfield_avg_cp, Direction{0}, lev), lev, "Bx_avg_cp");
+                read_mf(*m_fields.get(FieldType::Bfield_avg_cp, Direction{1}, lev), lev, "By_avg_cp");
+                read_mf(*m_fields.get(FieldType::Bfield_avg_cp, Direction{2}, lev), lev, "Bz_avg_cp");
             }
 
             if (is_synchronized) {
-                VisMF::Read(*m_fields.get(FieldType::current_cp, Direction{0}, lev),
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jx_cp"));
-                VisMF::Read(*m_fields.get(FieldType::current_cp, Direction{1}, lev),
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jy_cp"));
-                VisMF::Read(*m_fields.get(FieldType::current_cp, Direction{2}, lev),
-                            amrex::MultiFabFileFullPrefix(lev, restart_chkfile, level_prefix, "jz_cp"));
+                read_mf(*m_fields.get(FieldType::current_cp, Direction{0}, lev), lev, "jx_cp");
+                read_mf(*m_fields.get(FieldType::current_cp, Direction{1}, lev), lev, "jy_cp");
+                read_mf(*m_fields.get(FieldType::current_cp, Direction{2}, lev), lev, "jz_cp");
             }
         }
     }
@@ -398,10 +518,189 @@ WarpX::InitFromCheckpoint ()
         }
     }
 
+    timer_fields.record_stop_time();
+
     if (EB::enabled()) { InitializeEBGridData(maxLevel()); }
 
     // Initialize particles
+    timer_particles.record_start_time();
     mypc->AllocData();
     mypc->Restart(restart_chkfile);
+    timer_particles.record_stop_time();
+
+    const double header_time = timer_header.get_global_duration();
+    const double fields_time = timer_fields.get_global_duration();
+    const double particles_time = timer_particles.get_global_duration();
+    std::stringstream ss;
+    ss << "restart: read header and metadata in " << header_time << " s, "
+       << "fields in " << fields_time << " s, "
+       << "particles in " << particles_time << " s";
+    amrex::Print() << Utils::TextMsg::Info(ss.str());
+}
+
+void
+WarpX::SaveMemoryCheckpoint ()
+{
+    WARPX_PROFILE("WarpX::SaveMemoryCheckpoint()");
+
+    // Release the previous checkpoint first, so that at most one copy
+    // of the simulation state is held in host memory
+    m_memory_checkpoint.reset();
+    auto ckpt = std::make_unique<MemoryCheckpoint>();
+
+    ckpt->istep = istep;
+    ckpt->nsubsteps = nsubsteps;
+    ckpt->t_new = t_new;
+    ckpt->t_old = t_old;
+    ckpt->dt = dt;
+    ckpt->prob_domain = Geom(0).ProbDomain();
+    ckpt->moving_window_x = moving_window_x;
+    ckpt->time_of_last_gal_shift = time_of_last_gal_shift;
+    ckpt->is_synchronized = is_synchronized;
+
+    // Fields, including guard cells. Aliases share the data of their owner
+    // and are therefore restored along with it.
+    for (const auto& name : m_fields.list_owned()) {
+        amrex::MultiFab const& mf = *m_fields.internal_get(name);
+        amrex::MultiFab& saved = ckpt->fields.try_emplace(
+            name, mf.boxArray(), mf.DistributionMap(), mf.nComp(), mf.nGrowVect(),
+            amrex::MFInfo().SetArena(amrex::The_Pinned_Arena())).first->second;
+        amrex::MultiFab::Copy(saved, mf, 0, 0, mf.nComp(), mf.nGrowVect());
+    }
+
+    // Particles of all species and lasers, with the grids on which they are stored
+    for (int i = 0; i < mypc->nContainers(); ++i) {
+        WarpXParticleContainer& pc = mypc->GetParticleContainer(i);
+        ckpt->particles.push_back(std::make_unique<PinnedMemoryParticleContainer>(
+            pc.make_alike<amrex::PinnedArenaAllocator>()));
+        ckpt->particles.back()->copyParticles(pc, true);
+        ckpt->injection_position.push_back(pc.m_current_injection_position);
+    }
+    for (int lev = 0; lev <= finest_level; ++lev) {
+        ckpt->particle_ba.push_back(boxArray(lev));
+        ckpt->particle_dm.push_back(DistributionMap(lev));
+    }
+
+    // Mirror the valid cells of the fields and the particles to the partner rank
+    if (m_memory_checkpoint_mirror) {
+        ckpt->mirrored = true;
+        for (const auto& name : m_fields.list_owned()) {
+            amrex::MultiFab const& mf = *m_fields.internal_get(name);
+            amrex::MultiFab& partner_mf = ckpt->partner_fields.try_emplace(
+                name, mf.boxArray(), PartnerDistributionMapping(mf.DistributionMap()),
+                mf.nComp(), 0, amrex::MFInfo().SetArena(amrex::The_Pinned_Arena())).first->second;
+            partner_mf.ParallelCopy(mf, 0, 0, mf.nComp());
+        }
+
+        int const partner = MemoryCheckpointPartner();
+        ckpt->partner_particles.resize(mypc->nContainers());
+        for (int i = 0; i < mypc->nContainers(); ++i) {
+            auto const& saved = *ckpt->particles[i];
+            for (int lev = 0; lev <= finest_level; ++lev) {
+                PinnedTile local;
+                local.define(saved.NumRuntimeRealComps(), saved.NumRuntimeIntComps());
+                for (auto const& kv : saved.GetParticles(lev)) { AppendParticles(local, kv.second); }
+
+                PinnedTile& partner_tile = ckpt->partner_particles[i].emplace_back();
+                partner_tile.define(saved.NumRuntimeRealComps(), saved.NumRuntimeIntComps());
+                if (partner >= 0) { ExchangeTileWithPartner(local, partner_tile, partner); }
+            }
+        }
+    }
+
+    m_memory_checkpoint = std::move(ckpt);
+
+    if (verbose) {
+        amrex::Print() << Utils::TextMsg::Info(
+            "Saved in-memory checkpoint at step " + std::to_string(istep[0]));
+    }
+}
+
+void
+WarpX::RestoreMemoryCheckpoint (bool const from_partner)
+{
+    WARPX_PROFILE("WarpX::RestoreMemoryCheckpoint()");
+
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_memory_checkpoint != nullptr,
+        "RestoreMemoryCheckpoint: no in-memory checkpoint was saved");
+    auto const& ckpt = *m_memory_checkpoint;
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!from_partner || ckpt.mirrored,
+        "RestoreMemoryCheckpoint: restoring from the partner rank requires warpx.memory_checkpoint_mirror = 1");
+
+    istep = ckpt.istep;
+    nsubsteps = ckpt.nsubsteps;
+    t_new = ckpt.t_new;
+    t_old = ckpt.t_old;
+    dt = ckpt.dt;
+    ResetProbDomain(ckpt.prob_domain);
+    moving_window_x = ckpt.moving_window_x;
+    time_of_last_gal_shift = ckpt.time_of_last_gal_shift;
+    is_synchronized = ckpt.is_synchronized;
+
+    for (auto const& [name, local_copy] : ckpt.fields) {
+        amrex::MultiFab* mf = m_fields.internal_get(name);
+        if (mf == nullptr) { continue; }
+        // The copy of the partner rank only holds the valid cells:
+        // it is always copied as if the grids had changed
+        amrex::MultiFab const& saved = from_partner ? ckpt.partner_fields.at(name) : local_copy;
+        if (!from_partner && mf->boxArray() == saved.boxArray() &&
+            mf->DistributionMap() == saved.DistributionMap()) {
+            amrex::MultiFab::Copy(*mf, saved, 0, 0, saved.nComp(),
+                amrex::min(saved.nGrowVect(), mf->nGrowVect()));
+        } else {
+            // The grids were changed (e.g., by load balancing) since the checkpoint:
+            // only the valid cells are copied, and the guard cells are filled by the
+            // exchanges done during the next step.
+            mf->ParallelCopy(saved, 0, 0, saved.nComp(), amrex::IntVect(0), mf->nGrowVect());
+        }
+    }
+
+    bool same_grids = (static_cast<int>(ckpt.particle_ba.size()) == finest_level + 1);
+    for (int lev = 0; same_grids && lev <= finest_level; ++lev) {
+        same_grids = (boxArray(lev) == ckpt.particle_ba[lev] &&
+                      DistributionMap(lev) == ckpt.particle_dm[lev]);
+    }
+    int const partner = from_partner ? MemoryCheckpointPartner() : -1;
+
+    for (int i = 0; i < mypc->nContainers(); ++i) {
+        WarpXParticleContainer& pc = mypc->GetParticleContainer(i);
+        auto const& saved = *ckpt.particles[i];
+        if (same_grids && !from_partner) {
+            pc.copyParticles(saved, false);
+        } else {
+            // The tiles of the copy are indexed by the grids of the checkpoint, which may
+            // not exist anymore on this rank (or may be held by the partner rank):
+            // add the particles to grid 0 and tile 0, and let Redistribute()
+            // move them to their proper places.
+            pc.clearParticles();
+            int const nlevs_saved = from_partner ?
+                static_cast<int>(ckpt.partner_particles[i].size()) :
+                static_cast<int>(saved.GetParticles().size());
+            for (int lev = 0; lev < nlevs_saved; ++lev) {
+                auto& particle_tile = pc.DefineAndReturnParticleTile(
+                    std::min(lev, finest_level), 0, 0);
+                if (partner >= 0) {
+                    PinnedTile own_tile;
+                    own_tile.define(saved.NumRuntimeRealComps(), saved.NumRuntimeIntComps());
+                    ExchangeTileWithPartner(ckpt.partner_particles[i][lev], own_tile, partner);
+                    AppendParticles(particle_tile, own_tile);
+                } else {
+                    for (auto const& kv : saved.GetParticles(lev)) {
+                        AppendParticles(particle_tile, kv.second);
+                    }
+                }
+            }
+            pc.Redistribute();
+        }
+        pc.m_current_injection_position = ckpt.injection_position[i];
+    }
+
+    for (int lev = 0; lev <= finest_level; ++lev) {
+        m_accelerator_lattice[lev]->UpdateElementFinder(lev);
+    }
+
+    m_memory_checkpoint_restored = true;
 
+    amrex::Print() << Utils::TextMsg::Info(
+        "Restored in-memory checkpoint of step " + std::to_string(istep[0]));
 }
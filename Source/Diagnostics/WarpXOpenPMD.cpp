@@ -7,6 +7,7 @@
 #include "WarpXOpenPMD.H"
 
 #include "Particles/ParticleIO.H"
+#include "Diagnostics/IOAggregation.H"
 #include "Diagnostics/ParticleDiag/ParticleDiag.H"
 #include "FieldIO.H"
 #include "Particles/Filter/FilterFunctors.H"
@@ -28,6 +29,7 @@
 #include <AMReX_DataAllocator.H>
 #include <AMReX_FArrayBox.H>
 #include <AMReX_FabArray.H>
+#include <AMReX_GpuContainers.H>
 #include <AMReX_GpuQualifiers.H>
 #include <AMReX_IntVect.H>
 #include <AMReX_MFIter.H>
@@ -38,10 +40,13 @@
 #include <AMReX_Particle.H>
 #include <AMReX_Particles.H>
 #include <AMReX_Periodicity.H>
+#include <AMReX_Random.H>
+#include <AMReX_Scan.H>
 #include <AMReX_StructOfArrays.H>
 
 #include <algorithm>
 #include <cctype>
+#include <cmath>
 #include <cstdint>
 #include <iostream>
 #include <map>
@@ -368,6 +373,131 @@ namespace detail
                                   });
         }
     }
+
+    /** \brief Get the openPMD names of the particle attributes and whether they are written
+     *
+     * @param[in] pc particle container of the species
+     * @param[in] plot_flags whether each of the compile-time real attributes is written
+     * @param[out] real_names names of the real attributes
+     * @param[out] int_names names of the int attributes
+     * @param[out] real_flags whether each real attribute is written
+     * @param[out] int_flags whether each int attribute is written
+     */
+    template <typename PC>
+    void
+    getParticleComponentNames (PC const& pc,
+                               amrex::Vector<int> const& plot_flags,
+                               amrex::Vector<std::string>& real_names,
+                               amrex::Vector<std::string>& int_names,
+                               amrex::Vector<int>& real_flags,
+                               amrex::Vector<int>& int_flags)
+    {
+        // see openPMD ED-PIC extension for namings
+        // note: an underscore separates the record name from its component
+        //       for non-scalar records
+        // note: in RZ, we reconstruct x,y,z positions from r,z,theta in WarpX
+#if !defined (WARPX_DIM_1D_Z)
+        real_names.push_back("position_x");
+#endif
+#if defined (WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
+        real_names.push_back("position_y");
+#endif
+        real_names.push_back("position_z");
+        real_names.push_back("weighting");
+        real_names.push_back("momentum_x");
+        real_names.push_back("momentum_y");
+        real_names.push_back("momentum_z");
+        // get the names of the real comps
+        real_names.resize(pc.NumRealComps());
+        auto runtime_rnames = pc.getParticleRuntimeComps();
+        for (auto const& x : runtime_rnames)
+        {
+            real_names[x.second+PIdx::nattribs] = detail::snakeToCamel(x.first);
+        }
+        // plot any "extra" fields by default
+        real_flags = plot_flags;
+        real_flags.resize(pc.NumRealComps(), 1);
+        // and the names
+        int_names.resize(pc.NumIntComps());
+        auto runtime_inames = pc.getParticleRuntimeiComps();
+        for (auto const& x : runtime_inames)
+        {
+            int_names[x.second+0] = detail::snakeToCamel(x.first);
+        }
+        // plot by default
+        int_flags.resize(pc.NumIntComps(), 1);
+    }
+
+    /** \brief Evaluate a particle filter on each tile and compact the indices of the selected particles
+     *
+     * The tiles are visited in the same order as WarpXParIter, so that the result
+     * can be matched with the tiles in a later loop over the particles.
+     *
+     * @param[in] pc particle container of the species
+     * @param[in] filter functor returning whether a particle is selected
+     * @return for each level and each local tile, the indices of the selected particles
+     */
+    template <typename F>
+    amrex::Vector<amrex::Vector<amrex::Gpu::DeviceVector<int>>>
+    SelectParticles (WarpXParticleContainer& pc, F const& filter)
+    {
+        amrex::Vector<amrex::Vector<amrex::Gpu::DeviceVector<int>>> selection(pc.finestLevel()+1);
+        for (int lev = 0; lev <= pc.finestLevel(); ++lev) {
+            for (WarpXParIter pti(pc, lev); pti.isValid(); ++pti) {
+                auto const np = static_cast<int>(pti.numParticles());
+                auto& indices = selection[lev].emplace_back();
+                if (np == 0) { continue; }
+
+                amrex::Gpu::DeviceVector<int> mask(np);
+                amrex::Gpu::DeviceVector<int> all_indices(np);
+                int* const p_mask = mask.dataPtr();
+                int* const p_all_indices = all_indices.dataPtr();
+                auto const ptd = pti.GetParticleTile().getConstParticleTileData();
+
+                amrex::ParallelForRNG(np,
+                    [=] AMREX_GPU_DEVICE (int ip, amrex::RandomEngine const& engine) noexcept
+                    {
+                        p_mask[ip] = filter(ptd, ip, engine) ? 1 : 0;
+                    });
+                int const nselected = amrex::Scan::PrefixSum<int>(np,
+                    [=] AMREX_GPU_DEVICE (int ip) -> int { return p_mask[ip]; },
+                    [=] AMREX_GPU_DEVICE (int ip, int const& s) {
+                        if (p_mask[ip]) { p_all_indices[s] = ip; }
+                    },
+                    amrex::Scan::Type::exclusive, amrex::Scan::retSum);
+
+                indices.resize(nselected);
+                amrex::Gpu::copyAsync(amrex::Gpu::deviceToDevice,
+                    all_indices.begin(), all_indices.begin() + nselected, indices.begin());
+                amrex::Gpu::streamSynchronize();
+            }
+        }
+        return selection;
+    }
+
+    /** \brief Write n values to a record component, directly into the buffer of the backend
+     *
+     * @param[in] comp the openPMD record component
+     * @param[in] offset offset of the first value in the record component
+     * @param[in] n number of values
+     * @param[in] get functor returning the i-th value
+     */
+    template <typename T, typename F>
+    void
+    storeSelected (openPMD::RecordComponent comp, uint64_t const offset, int const n, F const& get)
+    {
+        auto span = comp.storeChunk<T>({offset}, {static_cast<uint64_t>(n)});
+        T* const dst = span.currentBuffer().data();
+#ifdef AMREX_USE_GPU
+        amrex::Gpu::DeviceVector<T> buffer(n);
+        T* const p_buffer = buffer.dataPtr();
+        amrex::ParallelFor(n, [=] AMREX_GPU_DEVICE (int i) noexcept { p_buffer[i] = get(i); });
+        amrex::Gpu::copyAsync(amrex::Gpu::deviceToHost, buffer.begin(), buffer.end(), dst);
+        amrex::Gpu::streamSynchronize();
+#else
+        for (int i = 0; i < n; ++i) { dst[i] = get(i); }
+#endif
+    }
 #endif // WARPX_USE_OPENPMD
 } // namespace detail
 
@@ -541,10 +671,6 @@ for (unsigned i = 0, n = particle_diags.size(); i < n; ++i) {
         }
     }
 
-    PinnedMemoryParticleContainer tmp = (isBTD || use_pinned_pc) ?
-        pinned_pc->make_alike<amrex::PinnedArenaAllocator>() :
-        pc->make_alike<amrex::PinnedArenaAllocator>();
-
     const auto mass = pc->AmIA<PhysicalSpecies::photon>() ? PhysConst::m_e : pc->getMass();
     RandomFilter const random_filter(particle_diags[i].m_do_random_filter,
                                      particle_diags[i].m_random_fraction);
@@ -558,31 +684,55 @@ for (unsigned i = 0, n = particle_diags.size(); i < n; ++i) {
     GeometryFilter const geometry_filter(particle_diags[i].m_do_geom_filter,
                                            particle_diags[i].m_diag_domain);
 
+    using SrcData = WarpXParticleContainer::ParticleTileType::ConstParticleTileDataType;
+    auto const particle_filter = [random_filter,uniform_filter,parser_filter,geometry_filter]
+        AMREX_GPU_HOST_DEVICE
+        (const SrcData& src, int ip, const amrex::RandomEngine& engine)
+        {
+            const SuperParticleType& p = src.getSuperParticle(ip);
+            return random_filter(p, engine) * uniform_filter(p, engine)
+                    * parser_filter(p, engine) * geometry_filter(p, engine);
+        };
+
+    // names of amrex::Real and int particle attributes in SoA data
+    amrex::Vector<std::string> real_names;
+    amrex::Vector<std::string> int_names;
+    amrex::Vector<int> int_flags;
+    amrex::Vector<int> real_flags;
+
+    // Unless phi is gathered on the particles or the particles are aggregated on
+    // writer ranks, the selected particles are written directly from the species,
+    // without an intermediate copy
+    bool const write_directly = !isBTD && !use_pinned_pc && !particle_diags[i].m_plot_phi
+        && WarpX::GetInstance().getIOAggregationFactor() == 1;
+    if (write_directly) {
+        detail::getParticleComponentNames(*pc, particle_diags[i].m_plot_flags,
+            real_names, int_names, real_flags, int_flags);
+
+        particlesConvertUnits(ConvertDirection::WarpX_to_SI, pc, mass);
+        auto const selection = detail::SelectParticles(*pc, particle_filter);
+        DumpSelectedToFile(pc, selection,
+            particle_diags.at(i).getSpeciesName(),
+            m_CurrentStep,
+            real_flags,
+            int_flags,
+            real_names, int_names,
+            pc->getCharge(), pc->getMass());
+        particlesConvertUnits(ConvertDirection::SI_to_WarpX, pc, mass);
+        continue;
+    }
+
+    PinnedMemoryParticleContainer tmp = (isBTD || use_pinned_pc) ?
+        pinned_pc->make_alike<amrex::PinnedArenaAllocator>() :
+        pc->make_alike<amrex::PinnedArenaAllocator>();
+
     if (isBTD || use_pinned_pc) {
         particlesConvertUnits(ConvertDirection::WarpX_to_SI, pinned_pc, mass);
-        using SrcData = WarpXParticleContainer::ParticleTileType::ConstParticleTileDataType;
-        tmp.copyParticles(*pinned_pc,
-            [random_filter,uniform_filter,parser_filter,geometry_filter]
-            AMREX_GPU_HOST_DEVICE
-            (const SrcData& src, int ip, const amrex::RandomEngine& engine)
-            {
-                const SuperParticleType& p = src.getSuperParticle(ip);
-                return random_filter(p, engine) * uniform_filter(p, engine)
-                        * parser_filter(p, engine) * geometry_filter(p, engine);
-            }, true);
+        tmp.copyParticles(*pinned_pc, particle_filter, true);
         particlesConvertUnits(ConvertDirection::SI_to_WarpX, pinned_pc, mass);
     } else {
         particlesConvertUnits(ConvertDirection::WarpX_to_SI, pc, mass);
-        using SrcData = WarpXParticleContainer::ParticleTileType::ConstParticleTileDataType;
-        tmp.copyParticles(*pc,
-            [random_filter,uniform_filter,parser_filter,geometry_filter]
-            AMREX_GPU_HOST_DEVICE
-            (const SrcData& src, int ip, const amrex::RandomEngine& engine)
-            {
-                const SuperParticleType& p = src.getSuperParticle(ip);
-                return random_filter(p, engine) * uniform_filter(p, engine)
-                        * parser_filter(p, engine) * geometry_filter(p, engine);
-            }, true);
+        tmp.copyParticles(*pc, particle_filter, true);
         particlesConvertUnits(ConvertDirection::SI_to_WarpX, pc, mass);
     }
 
@@ -591,45 +741,12 @@ for (unsigned i = 0, n = particle_diags.size(); i < n; ++i) {
         storePhiOnParticles( tmp, WarpX::electrostatic_solver_id, !use_pinned_pc );
     }
 
-    // names of amrex::Real and int particle attributes in SoA data
-    amrex::Vector<std::string> real_names;
-    amrex::Vector<std::string> int_names;
-    amrex::Vector<int> int_flags;
-    amrex::Vector<int> real_flags;
-    // see openPMD ED-PIC extension for namings
-    // note: an underscore separates the record name from its component
-    //       for non-scalar records
-    // note: in RZ, we reconstruct x,y,z positions from r,z,theta in WarpX
-#if !defined (WARPX_DIM_1D_Z)
-    real_names.push_back("position_x");
-#endif
-#if defined (WARPX_DIM_3D) || defined(WARPX_DIM_RZ)
-    real_names.push_back("position_y");
-#endif
-    real_names.push_back("position_z");
-    real_names.push_back("weighting");
-    real_names.push_back("momentum_x");
-    real_names.push_back("momentum_y");
-    real_names.push_back("momentum_z");
-    // get the names of the real comps
-    real_names.resize(tmp.NumRealComps());
-    auto runtime_rnames = tmp.getParticleRuntimeComps();
-    for (auto const& x : runtime_rnames)
-    {
-        real_names[x.second+PIdx::nattribs] = detail::snakeToCamel(x.first);
-    }
-    // plot any "extra" fields by default
-    real_flags = particle_diags[i].m_plot_flags;
-    real_flags.resize(tmp.NumRealComps(), 1);
-    // and the names
-    int_names.resize(tmp.NumIntComps());
-    auto runtime_inames = tmp.getParticleRuntimeiComps();
-    for (auto const& x : runtime_inames)
-    {
-        int_names[x.second+0] = detail::snakeToCamel(x.first);
-    }
-    // plot by default
-    int_flags.resize(tmp.NumIntComps(), 1);
+    // Gather the particles on the writer ranks, if requested
+    warpx::diagnostics::AggregateParticles(
+        tmp, WarpX::GetInstance().getIOAggregationFactor());
+
+    detail::getParticleComponentNames(tmp, particle_diags[i].m_plot_flags,
+        real_names, int_names, real_flags, int_flags);
 
     // real_names contains a list of all real particle attributes.
     // real_flags is 1 or 0, whether quantity is dumped or not.
@@ -708,7 +825,7 @@ WarpXOpenPMDPlot::DumpToFile (ParticleContainer* pc,
     //   for BTD, we call this multiple times as we may resize in subsequent dumps if number of particles in the buffer > 0
     if (doParticleSetup || is_resizing_flush) {
         SetupPos(currSpecies, positionComponents, NewParticleVectorSize, isBTD);
-        SetupRealProperties(pc, currSpecies, write_real_comp, real_comp_names, write_int_comp, int_comp_names,
+        SetupRealProperties(currSpecies, write_real_comp, real_comp_names, write_int_comp, int_comp_names,
                             NewParticleVectorSize, isBTD);
     }
 
@@ -801,8 +918,120 @@ WarpXOpenPMDPlot::DumpToFile (ParticleContainer* pc,
 }
 
 void
-WarpXOpenPMDPlot::SetupRealProperties (ParticleContainer const * pc,
-                      openPMD::ParticleSpecies& currSpecies,
+WarpXOpenPMDPlot::DumpSelectedToFile (WarpXParticleContainer* pc,
+                    const amrex::Vector<amrex::Vector<amrex::Gpu::DeviceVector<int>>>& selection,
+                    const std::string& name,
+                    int iteration,
+                    const amrex::Vector<int>& write_real_comp,
+                    const amrex::Vector<int>& write_int_comp,
+                    const amrex::Vector<std::string>& real_comp_names,
+                    const amrex::Vector<std::string>&  int_comp_names,
+                    amrex::ParticleReal const charge,
+                    amrex::ParticleReal const mass)
+{
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(m_Series != nullptr, "openPMD: series must be initialized");
+
+    AMREX_ALWAYS_ASSERT(write_real_comp.size() == pc->NumRealComps());
+    AMREX_ALWAYS_ASSERT(write_int_comp.size() == pc->NumIntComps());
+    AMREX_ALWAYS_ASSERT(real_comp_names.size() == pc->NumRealComps());
+    AMREX_ALWAYS_ASSERT(int_comp_names.size() == pc->NumIntComps());
+
+    std::vector<long> num_selected_by_level(selection.size(), 0);
+    for (int lev = 0; lev < static_cast<int>(selection.size()); ++lev) {
+        for (auto const& indices : selection[lev]) {
+            num_selected_by_level[lev] += static_cast<long>(indices.size());
+        }
+    }
+    WarpXParticleCounter counter(num_selected_by_level);
+    auto const num_dump_particles = static_cast<unsigned long long>(counter.GetTotalNumParticles());
+
+    openPMD::Iteration currIteration = GetIteration(iteration, false);
+    openPMD::ParticleSpecies currSpecies = currIteration.particles[name];
+
+    auto const positionComponents = detail::getParticlePositionComponentLabels(write_real_comp, real_comp_names);
+    SetupPos(currSpecies, positionComponents, num_dump_particles, false);
+    SetupRealProperties(currSpecies, write_real_comp, real_comp_names, write_int_comp, int_comp_names,
+                        num_dump_particles, false);
+    SetConstParticleRecordsEDPIC(currSpecies, positionComponents, num_dump_particles, charge, mass);
+
+    // open files from all processors, in case some will not contribute below
+    m_Series->flush();
+
+    auto const getComponentRecord = [&currSpecies](std::string const& comp_name) {
+        // handle scalar and non-scalar records by name
+        const auto [record_name, component_name] = detail::name2openPMD(comp_name);
+        return currSpecies[record_name][component_name];
+    };
+
+    // dump the selected particles, reading the selected attributes directly from the SoA arrays
+    for (int lev = 0; lev < static_cast<int>(selection.size()); ++lev) {
+        auto offset = static_cast<uint64_t>( counter.m_ParticleOffsetAtRank[lev] );
+        int itile = 0;
+        for (WarpXParIter pti(*pc, lev); pti.isValid(); ++pti, ++itile) {
+            auto const& indices = selection[lev][itile];
+            auto const nselected = static_cast<int>(indices.size());
+
+            // Do not call storeChunk() with zero-sized particle tiles:
+            //   https://github.com/openPMD/openPMD-api/issues/1147
+            if (nselected == 0) { continue; }
+
+            int const* const p_indices = indices.dataPtr();
+            auto const& soa = pti.GetStructOfArrays();
+
+            uint64_t const* const p_idcpu = soa.GetIdCPUData().dataPtr();
+            detail::storeSelected<uint64_t>(getComponentRecord("id"), offset, nselected,
+                [=] AMREX_GPU_DEVICE (int ip) { return p_idcpu[p_indices[ip]]; });
+
+            auto const real_counter = std::min(write_real_comp.size(), real_comp_names.size());
+            for (auto idx=0; idx<real_counter; idx++) {
+                if (!write_real_comp[idx]) { continue; }
+#if defined(WARPX_DIM_RZ)
+                // reconstruct Cartesian positions for RZ simulations
+                // r,z,theta -> x,y,z
+                if (idx < 2) {
+                    amrex::ParticleReal const* const p_r = soa.GetRealData(PIdx::x).dataPtr();
+                    amrex::ParticleReal const* const p_theta = soa.GetRealData(PIdx::theta).dataPtr();
+                    bool const is_x = (idx == 0);
+                    detail::storeSelected<amrex::ParticleReal>(getComponentRecord(real_comp_names[idx]),
+                        offset, nselected,
+                        [=] AMREX_GPU_DEVICE (int ip) {
+                            int const j = p_indices[ip];
+                            return is_x ? p_r[j]*std::cos(p_theta[j]) : p_r[j]*std::sin(p_theta[j]);
+                        });
+                    continue;
+                }
+                // mak names and write flags to SoA real array number
+                int const soa_r_idx = idx - 1 < PIdx::theta ?
+                    idx - 1 :  // z and momenta before theta (we added y)
+                    idx        // jump over theta (skipped)
+                ;
+#else
+                int const soa_r_idx = idx;
+#endif
+                amrex::ParticleReal const* const p_real = soa.GetRealData(soa_r_idx).dataPtr();
+                detail::storeSelected<amrex::ParticleReal>(getComponentRecord(real_comp_names[idx]),
+                    offset, nselected,
+                    [=] AMREX_GPU_DEVICE (int ip) { return p_real[p_indices[ip]]; });
+            }
+
+            auto const int_counter = std::min(write_int_comp.size(), int_comp_names.size());
+            for (auto idx=0; idx<int_counter; idx++) {
+                if (!write_int_comp[idx]) { continue; }
+                int const* const p_int = soa.GetIntData(idx).dataPtr();
+                detail::storeSelected<int>(getComponentRecord(int_comp_names[idx]),
+                    offset, nselected,
+                    [=] AMREX_GPU_DEVICE (int ip) { return p_int[p_indices[ip]]; });
+            }
+
+            offset += static_cast<uint64_t>(nselected);
+        } // pti
+    } // lev
+
+    m_Series->flush();
+}
+
+void
+WarpXOpenPMDPlot::SetupRealProperties (openPMD::ParticleSpecies& currSpecies,
                       const amrex::Vector<int>& write_real_comp,
                       const amrex::Vector<std::string>& real_comp_names,
                       const amrex::Vector<int>& write_int_comp,
@@ -836,7 +1065,7 @@ WarpXOpenPMDPlot::SetupRealProperties (ParticleContainer const * pc,
     }
 
     std::set< std::string > addedRecords; // add meta-data per record only once
-    for (auto idx=0; idx<pc->NumRealComps(); idx++) {
+    for (auto idx=0; idx<real_counter; idx++) {
         if (write_real_comp[idx]) {
             // handle scalar and non-scalar records by name
             const auto [record_name, component_name] = detail::name2openPMD(real_comp_names[idx]);
@@ -1203,6 +1432,7 @@ WarpXOpenPMDPlot::SetupFields ( openPMD::Container< openPMD::Mesh >& meshes,
  * @param [in]: mesh          a mesh field
  * @param [in]: full_geom     geometry for the mesh
  * @param [in]: mesh_comp     a component for the mesh
+ * @param [in]: single_precision whether the component is written in single precision
  */
 void
 WarpXOpenPMDPlot::SetupMeshComp (openPMD::Mesh& mesh,
@@ -1210,7 +1440,8 @@ WarpXOpenPMDPlot::SetupMeshComp (openPMD::Mesh& mesh,
                                  std::string const& comp_name,
                                  std::string const& field_name,
                                  amrex::MultiFab const& mf,
-                                 bool var_in_theta_mode) const
+                                 bool var_in_theta_mode,
+                                 bool single_precision) const
 {
     auto mesh_comp = mesh[comp_name];
     amrex::Box const & global_box = full_geom.Domain();
@@ -1228,7 +1459,8 @@ WarpXOpenPMDPlot::SetupMeshComp (openPMD::Mesh& mesh,
     const std::vector<std::string> axis_labels = detail::getFieldAxisLabels(var_in_theta_mode);
 
     // Prepare the type of dataset that will be written
-    openPMD::Datatype const datatype = openPMD::determineDatatype<amrex::Real>();
+    openPMD::Datatype const datatype = single_precision ?
+        openPMD::determineDatatype<float>() : openPMD::determineDatatype<amrex::Real>();
     auto const dataset = openPMD::Dataset(datatype, global_size);
     mesh.setDataOrder(openPMD::Mesh::DataOrder::C);
     if (var_in_theta_mode) {
@@ -1334,7 +1566,9 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
                       const int iteration,
                       const double time,
                       bool isBTD,
-                      const amrex::Geometry& full_BTD_snapshot ) const
+                      const amrex::Geometry& full_BTD_snapshot,
+                      bool single_precision,
+                      int aggregation_factor ) const
 {
     //This is AMReX's tiny profiler. Possibly will apply it later
     WARPX_PROFILE("WarpXOpenPMDPlot::WriteOpenPMDFields()");
@@ -1396,7 +1630,8 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
                                         comp_name,
                                         field_name,
                                         mf[lev],
-                                        var_in_theta_mode );
+                                        var_in_theta_mode,
+                                        single_precision );
                     }
                 } else {
                     auto mesh = meshes[field_name];
@@ -1406,7 +1641,8 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
                                         comp_name,
                                         field_name,
                                         mf[lev],
-                                        var_in_theta_mode );
+                                        var_in_theta_mode,
+                                        single_precision );
                     }
                 }
             }
@@ -1426,11 +1662,20 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
             auto mesh = meshes[field_name];
             auto mesh_comp = mesh[comp_name];
 
+            // Gather this component on the writer ranks, if requested: this is done
+            // one component at a time, to limit the memory used on the writer ranks
+            amrex::MultiFab mf_aggregated;
+            if (aggregation_factor > 1) {
+                mf_aggregated = warpx::diagnostics::AggregateMultiFab(mf[lev], aggregation_factor, icomp, 1);
+            }
+            amrex::MultiFab const& mf_out = (aggregation_factor > 1) ? mf_aggregated : mf[lev];
+            int const icomp_out = (aggregation_factor > 1) ? 0 : icomp;
+
             // Loop through the multifab, and store each box as a chunk,
             // in the openPMD file.
-            for( amrex::MFIter mfi(mf[lev]); mfi.isValid(); ++mfi )
+            for( amrex::MFIter mfi(mf_out); mfi.isValid(); ++mfi )
             {
-                amrex::FArrayBox const& fab = mf[lev][mfi];
+                amrex::FArrayBox const& fab = mf_out[mfi];
                 amrex::Box const& local_box = fab.box();
 
                 // Determine the offset and size of this chunk
@@ -1443,6 +1688,18 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
                     chunk_size.emplace(chunk_size.begin(), 1);
                 }
 
+                if (single_precision) {
+                    // convert the chunk on the host
+                    amrex::FArrayBox fab_host(local_box, 1, amrex::The_Pinned_Arena());
+                    fab_host.copy<amrex::RunOn::Device>(fab, local_box, icomp_out, local_box, 0, 1);
+                    amrex::Gpu::streamSynchronize();
+                    auto const npts = static_cast<std::size_t>(local_box.numPts());
+                    std::shared_ptr<float> data_float(new float[npts], std::default_delete<float[]>());
+                    std::copy_n(fab_host.dataPtr(), npts, data_float.get());
+                    mesh_comp.storeChunk(data_float, chunk_offset, chunk_size);
+                    continue;
+                }
+
                 // we avoid relying on managed memory by copying explicitly to host
                 //   remove the copies and "streamSynchronize" if you like to pass
                 //   GPU pointers to the I/O library
@@ -1450,17 +1707,25 @@ WarpXOpenPMDPlot::WriteOpenPMDFieldsAll ( //const std::string& filename,
                 if (fab.arena()->isManaged() || fab.arena()->isDevice()) {
                     amrex::BaseFab<amrex::Real> foo(local_box, 1, amrex::The_Pinned_Arena());
                     std::shared_ptr<amrex::Real> data_pinned(foo.release());
-                    amrex::Gpu::dtoh_memcpy_async(data_pinned.get(), fab.dataPtr(icomp), local_box.numPts()*sizeof(amrex::Real));
+                    amrex::Gpu::dtoh_memcpy_async(data_pinned.get(), fab.dataPtr(icomp_out), local_box.numPts()*sizeof(amrex::Real));
                     // intentionally delayed until before we .flush(): amrex::Gpu::streamSynchronize();
                     mesh_comp.storeChunk(data_pinned, chunk_offset, chunk_size);
                 } else
 #endif
                 {
-                    amrex::Real const *local_data = fab.dataPtr(icomp);
+                    amrex::Real const *local_data = fab.dataPtr(icomp_out);
                     mesh_comp.storeChunkRaw(
                         local_data, chunk_offset, chunk_size);
                 }
             }
+
+            // The aggregated data must be written before it is freed
+            if (aggregation_factor > 1) {
+#ifdef AMREX_USE_GPU
+                amrex::Gpu::streamSynchronize();
+#endif
+                m_Series->flush();
+            }
         } // icomp store loop
 
 #ifdef AMREX_USE_GPU
@@ -1481,18 +1746,34 @@ WarpXParticleCounter::WarpXParticleCounter (ParticleContainer* pc):
     m_MPIRank{amrex::ParallelDescriptor::MyProc()},
     m_MPISize{amrex::ParallelDescriptor::NProcs()}
 {
-    m_ParticleCounterByLevel.resize(pc->finestLevel()+1);
-    m_ParticleOffsetAtRank.resize(pc->finestLevel()+1);
-    m_ParticleSizeAtRank.resize(pc->finestLevel()+1);
-
+    std::vector<long> num_particles_by_level(pc->finestLevel()+1, 0);
     for (auto currentLevel = 0; currentLevel <= pc->finestLevel(); currentLevel++)
     {
-        long numParticles = 0; // numParticles in this processor
-
         for (ParticleIter pti(*pc, currentLevel); pti.isValid(); ++pti) {
-            auto numParticleOnTile = pti.numParticles();
-            numParticles += numParticleOnTile;
+            num_particles_by_level[currentLevel] += pti.numParticles();
         }
+    }
+    CountParticles(num_particles_by_level);
+}
+
+WarpXParticleCounter::WarpXParticleCounter (const std::vector<long>& num_particles_by_level):
+    m_MPIRank{amrex::ParallelDescriptor::MyProc()},
+    m_MPISize{amrex::ParallelDescriptor::NProcs()}
+{
+    CountParticles(num_particles_by_level);
+}
+
+void
+WarpXParticleCounter::CountParticles (const std::vector<long>& num_particles_by_level)
+{
+    auto const nlevels = static_cast<int>(num_particles_by_level.size());
+    m_ParticleCounterByLevel.resize(nlevels);
+    m_ParticleOffsetAtRank.resize(nlevels);
+    m_ParticleSizeAtRank.resize(nlevels);
+
+    for (auto currentLevel = 0; currentLevel < nlevels; currentLevel++)
+    {
+        long const numParticles = num_particles_by_level[currentLevel]; // numParticles in this processor
 
         unsigned long long offset=0; // offset of this level
         unsigned long long sum=0; // numParticles in this level (sum from all processors)
@@ -100,6 +100,9 @@ WarpX::Evolve (int numsteps)
 
     Real cur_time = t_new[0];
 
+    // A rollback done before this call is already reflected in istep and t_new
+    m_memory_checkpoint_restored = false;
+
     // Note that the default argument is numsteps = -1
     const int numsteps_max = (numsteps < 0)?(max_step):(istep[0] + numsteps);
 
@@ -238,6 +241,15 @@ WarpX::Evolve (int numsteps)
             t_old[i] = t_new[i];
             t_new[i] = cur_time;
         }
+
+        // If the corrected current was kept in spectral space by the PSATD push,
+        // transform it back only if a diagnostic uses it at this iteration
+        if (m_psatd_current_deferred &&
+            (multi_diags->DoComputeAndPack(step) ||
+             (reduced_diags->m_plot_rd != 0 && reduced_diags->DoComputeDiags(step)))) {
+            PSATDBackwardTransformDeferredJ();
+        }
+
         multi_diags->FilterComputePackFlush( step, false, true );
 
         const bool move_j = is_synchronized;
@@ -308,6 +320,18 @@ WarpX::Evolve (int numsteps)
         // execute afterdiagnostic callbacks
         ExecutePythonCallback("afterdiagnostics");
 
+        // A callback may have rolled the simulation back to an in-memory checkpoint:
+        // continue the loop from the restored step and time
+        if (m_memory_checkpoint_restored) {
+            m_memory_checkpoint_restored = false;
+            step = istep[0] - 1;
+            cur_time = t_new[0];
+        }
+        // Copy the state at the end of this step to host memory, for a later rollback
+        else if (m_memory_checkpoint_intervals.contains(step+1)) {
+            SaveMemoryCheckpoint();
+        }
+
         // inputs: unused parameters (e.g. typos) check after step 1 has finished
         if (!early_params_checked) {
             checkEarlyUnusedParams();
@@ -325,7 +349,7 @@ WarpX::Evolve (int numsteps)
                         << " DT = " << dt[0] << "\n";
             amrex::Print()<< "Evolve time = " << evolve_time
                       << " s; This step = " << evolve_time_end_step-evolve_time_beg_step
-                      << " s; Avg. per step = " << evolve_time/(step-step_begin+1) << " s\n\n";
+                      << " s; Avg. per step = " << evolve_time/std::max(step-step_begin+1, 1) << " s\n\n";
         }
 
         if (checkStopSimulation(cur_time)) {
@@ -333,6 +357,10 @@ WarpX::Evolve (int numsteps)
         }
     } // End loop on time steps
 
+    // Make the real-space current up to date when returning to the caller
+    // (e.g., PICMI, which may access J between calls of this routine)
+    PSATDBackwardTransformDeferredJ();
+
     // This if statement is needed for PICMI, which allows the Evolve routine to be
     // called multiple times, otherwise diagnostics will be done at every call,
     // regardless of the diagnostic period parameter provided in the inputs.
@@ -342,6 +370,11 @@ WarpX::Evolve (int numsteps)
         if (m_exit_loop_due_to_interrupt_signal) { ExecutePythonCallback("onbreaksignal"); }
     }
 
+    // Write the reduced diagnostics that are still buffered in memory
+    if (reduced_diags->m_plot_rd != 0) {
+        reduced_diags->FlushBuffers();
+    }
+
     amrex::Print() <<
         ablastr::warn_manager::GetWMInstance().PrintGlobalWarnings("THE END");
 }
@@ -10,11 +10,20 @@
 #include "ElectrostaticSolver.H"
 #include "EmbeddedBoundary/Enabled.H"
 #include "Fields.H"
+#include "Utils/TextMsg.H"
 
 #include <ablastr/fields/PoissonSolver.H>
+#if defined(WARPX_USE_FFT)
+#   include <ablastr/fields/FFTPoissonSolver.H>
+#endif
+
 
+#include <algorithm>
+#include <cmath>
+#include <memory>
 
 using namespace amrex;
+using namespace amrex::literals;
 using warpx::fields::FieldType;
 
 ElectrostaticSolver::ElectrostaticSolver (int nlevs_max) : num_levels{nlevs_max}
@@ -39,6 +48,91 @@ void ElectrostaticSolver::ReadParameters () {
     utils::parser::queryWithParser(
         pp_warpx, "self_fields_max_iters", self_fields_max_iters);
     pp_warpx.query("self_fields_verbosity", self_fields_verbosity);
+    pp_warpx.query_enum_sloppy(
+        "self_fields_initial_guess", self_fields_initial_guess, "-_");
+    utils::parser::queryWithParser(
+        pp_warpx, "self_fields_adaptive_tolerance_factor", self_fields_adaptive_tolerance_factor);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(self_fields_adaptive_tolerance_factor >= 0.0_rt,
+        "warpx.self_fields_adaptive_tolerance_factor must be non-negative");
+    pp_warpx.query("self_fields_direct_fft", self_fields_direct_fft);
+}
+
+bool
+ElectrostaticSolver::useDirectFFT (std::array<amrex::Real, 3> const beta) const
+{
+#if defined(WARPX_USE_FFT) && !defined(WARPX_DIM_RZ)
+    if (!self_fields_direct_fft) { return false; }
+    if (!m_poisson_boundary_handler->fft_compatible) { return false; }
+    if (num_levels != 1 || EB::enabled()) { return false; }
+    if (WarpX::grid_type == ablastr::utils::enums::GridType::Collocated) { return false; }
+    return (beta[0] == 0._rt && beta[1] == 0._rt && beta[2] == 0._rt);
+#else
+    amrex::ignore_unused(beta);
+    return false;
+#endif
+}
+
+void
+ElectrostaticSolver::setPhiInitialGuess (
+    ablastr::fields::MultiLevelScalarField const& phi)
+{
+    if (self_fields_initial_guess == PoissonInitialGuess::Previous) { return; }
+
+    if (self_fields_initial_guess == PoissonInitialGuess::Zero) {
+        for (int lev=0; lev < num_levels; lev++) {
+            phi[lev]->setVal(0.0_rt);
+        }
+        return;
+    }
+
+    // Extrapolated initial guess
+    m_phi_prev.resize(num_levels);
+    for (int lev=0; lev < num_levels; lev++) {
+        const amrex::MultiFab& phi_lev = *phi[lev];
+        const int ng = phi_lev.nGrow();
+        const bool has_prev = m_phi_prev[lev] &&
+            m_phi_prev[lev]->boxArray() == phi_lev.boxArray() &&
+            m_phi_prev[lev]->DistributionMap() == phi_lev.DistributionMap() &&
+            m_phi_prev[lev]->nGrow() == ng;
+        if (!has_prev) {
+            // First step, or the grids changed (e.g. after load balancing):
+            // start from the previous potential and keep a copy of it
+            m_phi_prev[lev] = std::make_unique<amrex::MultiFab>(
+                phi_lev.boxArray(), phi_lev.DistributionMap(), phi_lev.nComp(), ng);
+            amrex::MultiFab::Copy(*m_phi_prev[lev], phi_lev, 0, 0, phi_lev.nComp(), ng);
+            continue;
+        }
+        // m_phi_prev = 2 phi^{n} - phi^{n-1}, then swap so that phi holds
+        // the extrapolated guess and m_phi_prev holds phi^{n}
+        amrex::MultiFab::LinComb(*m_phi_prev[lev],
+            2.0_rt, phi_lev, 0, -1.0_rt, *m_phi_prev[lev], 0,
+            0, phi_lev.nComp(), ng);
+        amrex::MultiFab::Swap(*phi[lev], *m_phi_prev[lev], 0, 0, phi_lev.nComp(), ng);
+    }
+}
+
+amrex::Real
+ElectrostaticSolver::getRequiredPrecision (MultiParticleContainer& mpc) const
+{
+    if (self_fields_adaptive_tolerance_factor <= 0.0_rt) {
+        return self_fields_required_precision;
+    }
+
+    amrex::Long num_particles = 0;
+    for (auto const& pc : mpc) {
+        num_particles += pc->TotalNumberOfParticles();
+    }
+    if (num_particles == 0) { return self_fields_required_precision; }
+
+    auto & warpx = WarpX::GetInstance();
+    const auto num_cells = static_cast<amrex::Real>(warpx.boxArray(0).numPts());
+    const amrex::Real ppc = static_cast<amrex::Real>(num_particles) / num_cells;
+
+    // The statistical noise of the deposited charge density scales as 1/sqrt(ppc):
+    // converging the solver much further than this level does not improve the fields
+    const amrex::Real noise_level = 1.0_rt / std::sqrt(ppc);
+    return std::max(self_fields_required_precision,
+                    self_fields_adaptive_tolerance_factor * noise_level);
 }
 
 void
@@ -121,10 +215,26 @@ ElectrostaticSolver::computePhi (
     Real const required_precision,
     Real absolute_tolerance,
     int const max_iters,
-    int const verbosity) const
+    int const verbosity)
 {
     using ablastr::fields::Direction;
 
+    auto & warpx = WarpX::GetInstance();
+
+    last_required_precision = required_precision;
+
+#if defined(WARPX_USE_FFT) && !defined(WARPX_DIM_RZ)
+    if (useDirectFFT(beta)) {
+        // Direct solve: periodic boundaries, or periodic boundaries except for
+        // one direction with Dirichlet boundaries, whose potentials are the
+        // values of phi on these boundaries (as for MLMG)
+        ablastr::fields::computePhiFFTPeriodic(
+            *rho[0], *phi[0], warpx.Geom(0), m_poisson_boundary_handler->fft_dirichlet_dir);
+        amrex::ignore_unused(absolute_tolerance, max_iters, verbosity);
+        return;
+    }
+#endif
+
     // create a vector to our fields, sorted by level
     amrex::Vector<amrex::MultiFab *> sorted_rho;
     amrex::Vector<amrex::MultiFab *> sorted_phi;
@@ -140,7 +250,6 @@ ElectrostaticSolver::computePhi (
 #else
     std::optional<amrex::Vector<amrex::FArrayBoxFactory const *> > const eb_farray_box_factory;
 #endif
-    auto & warpx = WarpX::GetInstance();
     if (EB::enabled())
     {
         if (WarpX::electrostatic_solver_id == ElectrostaticSolverAlgo::LabFrame ||
@@ -189,7 +298,7 @@ ElectrostaticSolver::computePhi (
     bool const is_solver_igf_on_lev0 =
         WarpX::poisson_solver_id == PoissonSolverAlgo::IntegratedGreenFunction;
 
-    ablastr::fields::computePhi(
+    num_mlmg_iters += ablastr::fields::computePhi(
         sorted_rho,
         sorted_phi,
         beta,
@@ -36,6 +36,8 @@ void LabFrameExplicitES::ComputeSpaceChargeField (
     const MultiLevelScalarField phi_fp = fields.get_mr_levels(FieldType::phi_fp, max_level);
     const MultiLevelVectorField Efield_fp = fields.get_mr_levels_alldirs(FieldType::Efield_fp, max_level);
 
+    num_mlmg_iters = 0;
+
     mpc.DepositCharge(rho_fp, 0.0_rt);
     if (mfl) {
         const int lev = 0;
@@ -57,6 +59,9 @@ void LabFrameExplicitES::ComputeSpaceChargeField (
     // Todo: use simpler finite difference form with beta=0
     const std::array<Real, 3> beta = {0._rt};
 
+    // initial guess of the MLMG solver, before the boundary potentials are set
+    setPhiInitialGuess(phi_fp);
+
     // set the boundary potentials appropriately
     setPhiBC(phi_fp, warpx.gett_new(0));
 
@@ -73,7 +78,7 @@ void LabFrameExplicitES::ComputeSpaceChargeField (
         computePhiTriDiagonal(rho_fp, phi_fp);
 #else
         // Use the AMREX MLMG or the FFT (IGF) solver otherwise
-        computePhi(rho_fp, phi_fp, beta, self_fields_required_precision,
+        computePhi(rho_fp, phi_fp, beta, getRequiredPrecision(mpc),
                    self_fields_absolute_tolerance, self_fields_max_iters,
                    self_fields_verbosity);
 #endif
@@ -148,6 +148,25 @@ void PoissonBoundaryHandler::DefinePhiBCs (const amrex::Geometry& geom)
             }
         }
     }
+
+#ifndef WARPX_DIM_RZ
+    // Check whether the boundaries allow a direct FFT solve (with Multigrid selected)
+    if (WarpX::poisson_solver_id == PoissonSolverAlgo::Multigrid) {
+        int num_dirichlet_dims = 0;
+        bool all_supported = true;
+        for (int idim=0; idim<AMREX_SPACEDIM; idim++){
+            if (lobc[idim] == LinOpBCType::Periodic) { continue; }
+            if (lobc[idim] == LinOpBCType::Dirichlet && hibc[idim] == LinOpBCType::Dirichlet) {
+                fft_dirichlet_dir = idim;
+                num_dirichlet_dims++;
+            } else {
+                all_supported = false;
+            }
+        }
+        fft_compatible = all_supported && (num_dirichlet_dims <= 1);
+        if (!fft_compatible) { fft_dirichlet_dir = -1; }
+    }
+#endif
 }
 
 void PoissonBoundaryHandler::BuildParsers ()
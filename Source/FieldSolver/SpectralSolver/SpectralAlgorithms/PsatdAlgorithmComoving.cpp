@@ -168,6 +168,8 @@ void PsatdAlgorithmComoving::InitializeSpectralCoefficients (const SpectralKSpac
 
     // Loop over boxes and allocate the corresponding coefficients for each box
     for (amrex::MFIter mfi(ba, dm); mfi.isValid(); ++mfi) {
+        // Boxes of identical shape share the same coefficients
+        if (C_coef.isShared(mfi)) { continue; }
 
         const amrex::Box& bx = ba[mfi];
 
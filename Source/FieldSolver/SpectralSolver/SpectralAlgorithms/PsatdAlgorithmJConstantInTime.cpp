@@ -366,6 +366,9 @@ void PsatdAlgorithmJConstantInTime::InitializeSpectralCoefficients (
     // Loop over boxes and allocate the corresponding coefficients for each box
     for (amrex::MFIter mfi(ba, dm); mfi.isValid(); ++mfi)
     {
+        // Boxes of identical shape share the same coefficients
+        if (C_coef.isShared(mfi)) { continue; }
+
         const amrex::Box& bx = ba[mfi];
 
         // Extract pointers for the k vectors
@@ -527,6 +530,9 @@ void PsatdAlgorithmJConstantInTime::InitializeSpectralCoefficientsAveraging (
     // Loop over boxes and allocate the corresponding coefficients for each box
     for (amrex::MFIter mfi(ba, dm); mfi.isValid(); ++mfi)
     {
+        // Boxes of identical shape share the same coefficients
+        if (C_coef.isShared(mfi)) { continue; }
+
         const amrex::Box& bx = ba[mfi];
 
         // Extract pointers for the k vectors
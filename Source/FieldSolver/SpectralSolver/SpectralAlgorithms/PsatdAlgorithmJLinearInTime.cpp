@@ -270,6 +270,9 @@ void PsatdAlgorithmJLinearInTime::InitializeSpectralCoefficients (
     // Loop over boxes and allocate the corresponding coefficients for each box
     for (amrex::MFIter mfi(ba, dm); mfi.isValid(); ++mfi)
     {
+        // Boxes of identical shape share the same coefficients
+        if (C_coef.isShared(mfi)) { continue; }
+
         const amrex::Box& bx = ba[mfi];
 
         // Extract pointers for the k vectors
@@ -363,6 +366,9 @@ void PsatdAlgorithmJLinearInTime::InitializeSpectralCoefficientsAveraging (
     // Loop over boxes and allocate the corresponding coefficients for each box
     for (amrex::MFIter mfi(ba, dm); mfi.isValid(); ++mfi)
     {
+        // Boxes of identical shape share the same coefficients
+        if (C_coef.isShared(mfi)) { continue; }
+
         const amrex::Box& bx = ba[mfi];
 
         // Extract pointers for the k vectors
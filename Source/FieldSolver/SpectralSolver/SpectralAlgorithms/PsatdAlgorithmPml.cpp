@@ -386,6 +386,9 @@ void PsatdAlgorithmPml::InitializeSpectralCoefficients (
     // for each box owned by the local MPI process
     for (amrex::MFIter mfi(ba, dm); mfi.isValid(); ++mfi)
     {
+        // Boxes of identical shape share the same coefficients
+        if (C_coef.isShared(mfi)) { continue; }
+
         const amrex::Box& bx = ba[mfi];
 
         // Extract pointers for the k vectors
@@ -27,6 +27,7 @@
 #include <AMReX_MFIter.H>
 #include <AMReX_PODVector.H>
 #include <AMReX_REAL.H>
+#include <AMReX_Reduce.H>
 #include <AMReX_Utility.H>
 
 #if WARPX_USE_FFT
@@ -122,9 +123,17 @@ SpectralFieldData::SpectralFieldData( const int lev,
                                       const SpectralKSpace& k_space,
                                       const amrex::DistributionMapping& dm,
                                       const int n_field_required,
-                                      const bool periodic_single_box):
-    m_periodic_single_box{periodic_single_box}
+                                      const bool periodic_single_box,
+                                      const bool mixed_precision):
+    m_periodic_single_box{periodic_single_box},
+    m_mixed_precision{mixed_precision}
 {
+#ifndef ABLASTR_FFT_MIXED_PRECISION
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(!m_mixed_precision,
+        "psatd.do_mixed_precision=1 requires a double-precision build with "
+        "single-precision FFT support (see ABLASTR_FFT_MIXED_PRECISION)");
+#endif
+
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
     const bool do_costs = WarpXUtilLoadBalance::doCosts(cost, realspace_ba, dm);
 
@@ -136,8 +145,18 @@ SpectralFieldData::SpectralFieldData( const int lev,
 
     // Allocate temporary arrays - in real space and spectral space
     // These arrays will store the data just before/after the FFT
-    tmpRealField = MultiFab(realspace_ba, dm, 1, 0);
-    tmpSpectralField = SpectralField(spectralspace_ba, dm, 1, 0);
+    // (in single precision, with the mixed-precision mode)
+#ifdef ABLASTR_FFT_MIXED_PRECISION
+    if (m_mixed_precision) {
+        tmpRealFieldSingle = amrex::FabArray<amrex::BaseFab<float>>(realspace_ba, dm, 1, 0);
+        tmpSpectralFieldSingle = amrex::FabArray<amrex::BaseFab<amrex::GpuComplex<float>>>(
+            spectralspace_ba, dm, 1, 0);
+    } else
+#endif
+    {
+        tmpRealField = MultiFab(realspace_ba, dm, 1, 0);
+        tmpSpectralField = SpectralField(spectralspace_ba, dm, 1, 0);
+    }
 
     // By default, we assume the FFT is done from/to a nodal grid in real space
     // If the FFT is performed from/to a cell-centered grid in real space,
@@ -160,8 +179,16 @@ SpectralFieldData::SpectralFieldData( const int lev,
 #endif
 
     // Allocate and initialize the FFT plans
-    forward_plan = ablastr::math::anyfft::FFTplans(spectralspace_ba, dm);
-    backward_plan = ablastr::math::anyfft::FFTplans(spectralspace_ba, dm);
+#ifdef ABLASTR_FFT_MIXED_PRECISION
+    if (m_mixed_precision) {
+        forward_plan_single = ablastr::math::anyfft::FFTplansSingle(spectralspace_ba, dm);
+        backward_plan_single = ablastr::math::anyfft::FFTplansSingle(spectralspace_ba, dm);
+    } else
+#endif
+    {
+        forward_plan = ablastr::math::anyfft::FFTplans(spectralspace_ba, dm);
+        backward_plan = ablastr::math::anyfft::FFTplans(spectralspace_ba, dm);
+    }
     // Loop over boxes and allocate the corresponding plan
     // for each box owned by the local MPI proc
     for ( MFIter mfi(spectralspace_ba, dm); mfi.isValid(); ++mfi ){
@@ -176,15 +203,30 @@ SpectralFieldData::SpectralFieldData( const int lev,
         // the FFT plan, the valid dimensions are those of the real-space box.
         const IntVect fft_size = realspace_ba[mfi].length();
 
-        forward_plan[mfi] = ablastr::math::anyfft::CreatePlan(
-            fft_size, tmpRealField[mfi].dataPtr(),
-            reinterpret_cast<ablastr::math::anyfft::Complex*>( tmpSpectralField[mfi].dataPtr()),
-            ablastr::math::anyfft::direction::R2C, AMREX_SPACEDIM);
-
-        backward_plan[mfi] = ablastr::math::anyfft::CreatePlan(
-            fft_size, tmpRealField[mfi].dataPtr(),
-            reinterpret_cast<ablastr::math::anyfft::Complex*>( tmpSpectralField[mfi].dataPtr()),
-            ablastr::math::anyfft::direction::C2R, AMREX_SPACEDIM);
+#ifdef ABLASTR_FFT_MIXED_PRECISION
+        if (m_mixed_precision) {
+            forward_plan_single[mfi] = ablastr::math::anyfft::CreatePlanSingle(
+                fft_size, tmpRealFieldSingle[mfi].dataPtr(),
+                reinterpret_cast<ablastr::math::anyfft::ComplexSingle*>( tmpSpectralFieldSingle[mfi].dataPtr()),
+                ablastr::math::anyfft::direction::R2C, AMREX_SPACEDIM);
+
+            backward_plan_single[mfi] = ablastr::math::anyfft::CreatePlanSingle(
+                fft_size, tmpRealFieldSingle[mfi].dataPtr(),
+                reinterpret_cast<ablastr::math::anyfft::ComplexSingle*>( tmpSpectralFieldSingle[mfi].dataPtr()),
+                ablastr::math::anyfft::direction::C2R, AMREX_SPACEDIM);
+        } else
+#endif
+        {
+            forward_plan[mfi] = ablastr::math::anyfft::CreatePlan(
+                fft_size, tmpRealField[mfi].dataPtr(),
+                reinterpret_cast<ablastr::math::anyfft::Complex*>( tmpSpectralField[mfi].dataPtr()),
+                ablastr::math::anyfft::direction::R2C, AMREX_SPACEDIM);
+
+            backward_plan[mfi] = ablastr::math::anyfft::CreatePlan(
+                fft_size, tmpRealField[mfi].dataPtr(),
+                reinterpret_cast<ablastr::math::anyfft::Complex*>( tmpSpectralField[mfi].dataPtr()),
+                ablastr::math::anyfft::direction::C2R, AMREX_SPACEDIM);
+        }
 
         if (do_costs)
         {
@@ -204,15 +246,23 @@ SpectralFieldData::~SpectralFieldData()
             ablastr::math::anyfft::DestroyPlan(backward_plan[mfi]);
         }
     }
+#ifdef ABLASTR_FFT_MIXED_PRECISION
+    if (!tmpRealFieldSingle.empty()){
+        for ( MFIter mfi(tmpRealFieldSingle); mfi.isValid(); ++mfi ){
+            ablastr::math::anyfft::DestroyPlan(forward_plan_single[mfi]);
+            ablastr::math::anyfft::DestroyPlan(backward_plan_single[mfi]);
+        }
+    }
+#endif
 }
 
 /* \brief Transform the component `i_comp` of MultiFab `mf`
- *  to spectral space, and store the corresponding result internally
- *  (in the spectral field specified by `field_index`) */
+ *  to spectral space, and store the corresponding result in the
+ *  component `field_index` of the spectral field `dst` */
 void
 SpectralFieldData::ForwardTransform (const int lev,
-                                     const MultiFab& mf, const int field_index,
-                                     const int i_comp)
+                                     const MultiFab& mf, SpectralField& dst,
+                                     const int field_index, const int i_comp)
 {
     amrex::LayoutData<amrex::Real>* cost = WarpX::getCosts(lev);
     const bool do_costs = WarpXUtilLoadBalance::doCosts(cost, mf.boxArray(), mf.DistributionMap());
@@ -236,6 +286,14 @@ SpectralFieldData::ForwardTransform (const int lev,
         }
         auto wt = static_cast<amrex::Real>(amrex::second());
 
+#ifdef ABLASTR_FFT_MIXED_PRECISION
+        // In mixed-precision mode, the mean value of the field over the box
+        // (i.e. the k=0 mode, divided by the number of points) is kept in
+        // full precision and subtracted before the single-precision transform,
+        // so that a large uniform component does not swamp the fluctuations
+        Real dc_mode = 0._rt;
+#endif
+
         // Copy the real-space field `mf` to the temporary field `tmpRealField`
         // This ensures that all fields have the same number of points
         // before the Fourier transform.
@@ -249,25 +307,63 @@ SpectralFieldData::ForwardTransform (const int lev,
                 realspace_bx = mf[mfi].box(); // Keep guard cells
             }
             realspace_bx.enclosedCells(); // Discard last point in nodal direction
-            AMREX_ALWAYS_ASSERT( realspace_bx.contains(tmpRealField[mfi].box()) );
             const Array4<const Real> mf_arr = mf[mfi].array();
-            const Array4<Real> tmp_arr = tmpRealField[mfi].array();
-            ParallelFor( tmpRealField[mfi].box(),
-            [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                tmp_arr(i,j,k) = mf_arr(i,j,k,i_comp);
-            });
+#ifdef ABLASTR_FFT_MIXED_PRECISION
+            if (m_mixed_precision) {
+                const Box& tmp_bx = tmpRealFieldSingle[mfi].box();
+                AMREX_ALWAYS_ASSERT( realspace_bx.contains(tmp_bx) );
+
+                ReduceOps<ReduceOpSum> reduce_op;
+                ReduceData<Real> reduce_data(reduce_op);
+                using ReduceTuple = typename decltype(reduce_data)::Type;
+                reduce_op.eval(tmp_bx, reduce_data,
+                [=] AMREX_GPU_DEVICE(int i, int j, int k) -> ReduceTuple {
+                    return {mf_arr(i,j,k,i_comp)};
+                });
+                dc_mode = amrex::get<0>(reduce_data.value());
+                const Real mean = dc_mode / static_cast<Real>(tmp_bx.numPts());
+
+                const Array4<float> tmp_arr = tmpRealFieldSingle[mfi].array();
+                ParallelFor( tmp_bx,
+                [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+                    tmp_arr(i,j,k) = static_cast<float>(mf_arr(i,j,k,i_comp) - mean);
+                });
+            } else
+#endif
+            {
+                AMREX_ALWAYS_ASSERT( realspace_bx.contains(tmpRealField[mfi].box()) );
+                const Array4<Real> tmp_arr = tmpRealField[mfi].array();
+                ParallelFor( tmpRealField[mfi].box(),
+                [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
+                    tmp_arr(i,j,k) = mf_arr(i,j,k,i_comp);
+                });
+            }
         }
 
         // Perform Fourier transform from `tmpRealField` to `tmpSpectralField`
-        ablastr::math::anyfft::Execute(forward_plan[mfi]);
+#ifdef ABLASTR_FFT_MIXED_PRECISION
+        if (m_mixed_precision) {
+            ablastr::math::anyfft::Execute(forward_plan_single[mfi]);
+        } else
+#endif
+        {
+            ablastr::math::anyfft::Execute(forward_plan[mfi]);
+        }
 
         // Copy the spectral-space field `tmpSpectralField` to the appropriate
         // index of the FabArray `fields` (specified by `field_index`)
         // and apply correcting shift factor if the real space data comes
         // from a cell-centered grid in real space instead of a nodal grid.
         {
-            const Array4<Complex> fields_arr = SpectralFieldData::fields[mfi].array();
-            const Array4<const Complex> tmp_arr = tmpSpectralField[mfi].array();
+            const Array4<Complex> fields_arr = dst[mfi].array();
+            Array4<const Complex> tmp_arr;
+#ifdef ABLASTR_FFT_MIXED_PRECISION
+            const bool mixed_precision = m_mixed_precision;
+            Array4<const amrex::GpuComplex<float>> tmp_single_arr;
+            if (mixed_precision) { tmp_single_arr = tmpSpectralFieldSingle[mfi].const_array(); }
+            else
+#endif
+            { tmp_arr = tmpSpectralField[mfi].const_array(); }
 
             const Complex* shift0_arr = shift0_FFTfromCell[mfi].dataPtr();
 #if AMREX_SPACEDIM > 1
@@ -277,11 +373,20 @@ SpectralFieldData::ForwardTransform (const int lev,
 #endif
 #endif
             // Loop over indices within one box
-            const Box spectralspace_bx = tmpSpectralField[mfi].box();
+            const Box spectralspace_bx = dst[mfi].box();
 
             ParallelFor( spectralspace_bx,
             [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
-                Complex spectral_field_value = tmp_arr(i,j,k);
+                Complex spectral_field_value;
+#ifdef ABLASTR_FFT_MIXED_PRECISION
+                if (mixed_precision) {
+                    const amrex::GpuComplex<float> v = tmp_single_arr(i,j,k);
+                    spectral_field_value = Complex{v.real(), v.imag()};
+                    // Restore the k=0 mode, which was subtracted in full precision
+                    if (i == 0 && j == 0 && k == 0) { spectral_field_value += dc_mode; }
+                } else
+#endif
+                { spectral_field_value = tmp_arr(i,j,k); }
                 // Apply proper shift in each dimension
                 if (!is_nodal_0) { spectral_field_value *= shift0_arr[i]; }
 #if AMREX_SPACEDIM > 1
@@ -305,11 +410,12 @@ SpectralFieldData::ForwardTransform (const int lev,
 }
 
 
-/* \brief Transform spectral field specified by `field_index` back to
- * real space, and store it in the component `i_comp` of `mf` */
+/* \brief Transform the component `field_index` of the spectral field `src`
+ * back to real space, and store it in the component `i_comp` of `mf` */
 void
 SpectralFieldData::BackwardTransform (const int lev,
                                       MultiFab& mf,
+                                      const SpectralField& src,
                                       const int field_index,
                                       const amrex::IntVect& fill_guards,
                                       const int i_comp)
@@ -340,8 +446,15 @@ SpectralFieldData::BackwardTransform (const int lev,
         // and apply correcting shift factor if the field is to be transformed
         // to a cell-centered grid in real space instead of a nodal grid.
         {
-            const Array4<const Complex> field_arr = SpectralFieldData::fields[mfi].array();
-            const Array4<Complex> tmp_arr = tmpSpectralField[mfi].array();
+            const Array4<const Complex> field_arr = src[mfi].array();
+            Array4<Complex> tmp_arr;
+#ifdef ABLASTR_FFT_MIXED_PRECISION
+            const bool mixed_precision = m_mixed_precision;
+            Array4<amrex::GpuComplex<float>> tmp_single_arr;
+            if (mixed_precision) { tmp_single_arr = tmpSpectralFieldSingle[mfi].array(); }
+            else
+#endif
+            { tmp_arr = tmpSpectralField[mfi].array(); }
             const Complex* shift0_arr = shift0_FFTtoCell[mfi].dataPtr();
 #if AMREX_SPACEDIM > 1
             const Complex* shift1_arr = shift1_FFTtoCell[mfi].dataPtr();
@@ -350,7 +463,7 @@ SpectralFieldData::BackwardTransform (const int lev,
 #endif
 #endif
             // Loop over indices within one box
-            const Box spectralspace_bx = tmpSpectralField[mfi].box();
+            const Box spectralspace_bx = src[mfi].box();
 
             ParallelFor( spectralspace_bx,
             [=] AMREX_GPU_DEVICE(int i, int j, int k) noexcept {
@@ -364,21 +477,50 @@ SpectralFieldData::BackwardTransform (const int lev,
 #endif
 #endif
                 // Copy field into temporary array
-                tmp_arr(i,j,k) = spectral_field_value;
+#ifdef ABLASTR_FFT_MIXED_PRECISION
+                if (mixed_precision) {
+                    // The k=0 mode is added back in full precision after the transform
+                    if (i == 0 && j == 0 && k == 0) { spectral_field_value = Complex{0._rt, 0._rt}; }
+                    tmp_single_arr(i,j,k) = amrex::GpuComplex<float>{
+                        static_cast<float>(spectral_field_value.real()),
+                        static_cast<float>(spectral_field_value.imag())};
+                } else
+#endif
+                { tmp_arr(i,j,k) = spectral_field_value; }
             });
         }
 
         // Perform Fourier transform from `tmpSpectralField` to `tmpRealField`
-        ablastr::math::anyfft::Execute(backward_plan[mfi]);
+#ifdef ABLASTR_FFT_MIXED_PRECISION
+        if (m_mixed_precision) {
+            ablastr::math::anyfft::Execute(backward_plan_single[mfi]);
+        } else
+#endif
+        {
+            ablastr::math::anyfft::Execute(backward_plan[mfi]);
+        }
 
         // Copy the temporary field tmpRealField to the real-space field mf and
         // normalize, dividing by N, since (FFT + inverse FFT) results in a factor N
         {
             amrex::Box mf_box = (m_periodic_single_box) ? mfi.validbox() : mfi.fabbox();
             const amrex::Array4<amrex::Real> mf_arr = mf[mfi].array();
-            const amrex::Array4<const amrex::Real> tmp_arr = tmpRealField[mfi].array();
-
-            const amrex::Real inv_N = 1._rt / tmpRealField[mfi].box().numPts();
+            amrex::Array4<const amrex::Real> tmp_arr;
+            amrex::Real inv_N = 0._rt;
+#ifdef ABLASTR_FFT_MIXED_PRECISION
+            const bool mixed_precision = m_mixed_precision;
+            amrex::Array4<const float> tmp_single_arr;
+            // Full-precision k=0 mode, read from the spectral field on the device
+            const amrex::Array4<const Complex> field_arr = src[mfi].const_array();
+            if (mixed_precision) {
+                tmp_single_arr = tmpRealFieldSingle[mfi].const_array();
+                inv_N = 1._rt / tmpRealFieldSingle[mfi].box().numPts();
+            } else
+#endif
+            {
+                tmp_arr = tmpRealField[mfi].const_array();
+                inv_N = 1._rt / tmpRealField[mfi].box().numPts();
+            }
 
             // Total number of cells, including ghost cells (nj represents ny in 3D and nz in 2D)
             const int ni = mf_box.length(0);
@@ -415,7 +557,13 @@ SpectralFieldData::BackwardTransform (const int lev,
                 const int jj = (j == lo_j + nj - sj) ? lo_j : j;
                 const int kk = (k == lo_k + nk - sk) ? lo_k : k;
                 // Copy and normalize field
-                mf_arr(i,j,k,i_comp) = inv_N * tmp_arr(ii,jj,kk);
+#ifdef ABLASTR_FFT_MIXED_PRECISION
+                if (mixed_precision) {
+                    const amrex::Real dc_mode = field_arr(0,0,0,field_index).real();
+                    mf_arr(i,j,k,i_comp) = inv_N * (static_cast<amrex::Real>(tmp_single_arr(ii,jj,kk)) + dc_mode);
+                } else
+#endif
+                { mf_arr(i,j,k,i_comp) = inv_N * tmp_arr(ii,jj,kk); }
             });
         }
 
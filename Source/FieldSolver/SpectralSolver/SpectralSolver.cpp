@@ -19,10 +19,14 @@
 
 #include <ablastr/utils/Enums.H>
 
+#include <AMReX_MultiFab.H>
+
 #include <memory>
 
 #if WARPX_USE_FFT
 
+using namespace amrex::literals;
+
 SpectralSolver::SpectralSolver (
                 const int lev,
                 const amrex::BoxArray& realspace_ba,
@@ -41,7 +45,8 @@ SpectralSolver::SpectralSolver (
                 const JInTime J_in_time,
                 const RhoInTime rho_in_time,
                 const bool dive_cleaning,
-                const bool divb_cleaning)
+                const bool divb_cleaning,
+                const bool mixed_precision)
 {
     // Initialize all structures using the same distribution mapping dm
 
@@ -116,7 +121,8 @@ SpectralSolver::SpectralSolver (
 
     // - Initialize arrays for fields in spectral space + FFT plans
     field_data = SpectralFieldData(lev, realspace_ba, k_space, dm,
-                                   m_spectral_index.n_fields, periodic_single_box);
+                                   m_spectral_index.n_fields, periodic_single_box,
+                                   mixed_precision);
 }
 
 void
@@ -149,4 +155,29 @@ SpectralSolver::pushSpectralFields(){
     algorithm->pushSpectralFields( field_data );
 }
 
+amrex::Real
+SpectralSolver::TransformRoundTripError (const int lev,
+                                         const amrex::MultiFab& mf,
+                                         const int i_comp)
+{
+    WARPX_PROFILE("SpectralSolver::TransformRoundTripError");
+
+    // Forward and backward transforms, through the scratch spectral field
+    if (!m_round_trip_scratch.isDefined()) {
+        m_round_trip_scratch.define(field_data.fields.boxArray(),
+                                    field_data.fields.DistributionMap(), 1, 0);
+    }
+    amrex::MultiFab round_trip(mf.boxArray(), mf.DistributionMap(), 1, mf.nGrowVect());
+    field_data.ForwardTransform(lev, mf, m_round_trip_scratch, 0, i_comp);
+    field_data.BackwardTransform(lev, round_trip, m_round_trip_scratch, 0,
+                                 amrex::IntVect(0), 0);
+
+    // Maximum difference in the valid cells, relative to the maximum of the field
+    amrex::MultiFab::Subtract(round_trip, mf, i_comp, 0, 1, 0);
+    const amrex::Real max_error = round_trip.norm0(0, 0);
+    const amrex::Real max_field = mf.norm0(i_comp, 0);
+
+    return (max_field > 0._rt) ? max_error / max_field : max_error;
+}
+
 #endif // WARPX_USE_FFT
@@ -731,6 +731,9 @@ WarpX::PushPSATD ()
     std::string current_fp_string = "current_fp";
     std::string const current_cp_string = "current_cp";
 
+    // The real-space current has just been deposited (and synchronized)
+    m_psatd_current_deferred = false;
+
     if (fft_periodic_single_box)
     {
         if (current_correction)
@@ -743,8 +746,15 @@ WarpX::PushPSATD ()
             // Correct J in k-space
             PSATDCurrentCorrection();
 
-            // Inverse FFT of J
-            PSATDBackwardTransformJ(current_fp_string, current_cp_string);
+            // Inverse FFT of J: the push below uses the corrected J in k-space,
+            // so this can be deferred until real-space J is actually needed.
+            // Python callbacks may read J at any point, so do not defer it when
+            // any of them is installed.
+            if (m_psatd_spectral_resident_current && warpx_callback_py_map.empty()) {
+                m_psatd_current_deferred = true;
+            } else {
+                PSATDBackwardTransformJ(current_fp_string, current_cp_string);
+            }
         }
         else if (current_deposition_algo == CurrentDepositionAlgo::Vay)
         {
@@ -874,6 +884,18 @@ WarpX::PushPSATD ()
 #endif
 }
 
+void
+WarpX::PSATDBackwardTransformDeferredJ ()
+{
+#ifdef WARPX_USE_FFT
+    if (!m_psatd_current_deferred) { return; }
+
+    // The spectral current still holds the corrected current of the last PSATD push
+    PSATDBackwardTransformJ("current_fp", "current_cp");
+    m_psatd_current_deferred = false;
+#endif
+}
+
 void
 WarpX::EvolveB (amrex::Real a_dt, DtType a_dt_type)
 {
@@ -16,10 +16,14 @@
 #include "WarpX.H"
 
 #include <AMReX_ParmParse.H>
+#include <AMReX_Reduce.H>
 #include <AMReX_REAL.H>
 #include <AMReX_Vector.H>
 
+#include <algorithm>
+#include <cmath>
 #include <string>
+#include <vector>
 
 BackgroundMCCCollision::BackgroundMCCCollision (std::string const& collision_name)
     : CollisionBase(collision_name)
@@ -77,6 +81,11 @@ BackgroundMCCCollision::BackgroundMCCCollision (std::string const& collision_nam
         "The maximum background density must be greater than 0."
     );
 
+    // with a background density strongly varying in space, the maximum collision
+    // frequency can be calculated for each tile, from the local density and
+    // particle energies, so that fewer particles undergo null collisions
+    pp_collision_name.query("use_local_majorant", m_use_local_majorant);
+
     // if the neutral mass is specified use it, but if ionization is
     // included the mass of the secondary species of that interaction
     // will be used. If no neutral mass is specified and ionization is not
@@ -132,6 +141,11 @@ BackgroundMCCCollision::BackgroundMCCCollision (std::string const& collision_nam
         }
     }
 
+    // pack the cross-sections of the particle conserving processes in one table;
+    // the ionization process is not included, since there is at most one and it is
+    // evaluated in a separate kernel (ImpactIonization), which has nothing to share
+    m_scattering_cross_sections = ScatteringProcessTable(m_scattering_processes);
+
 #ifdef AMREX_USE_GPU
     amrex::Gpu::HostVector<ScatteringProcess::Executor> h_scattering_processes_exe;
     amrex::Gpu::HostVector<ScatteringProcess::Executor> h_ionization_processes_exe;
@@ -158,20 +172,25 @@ BackgroundMCCCollision::BackgroundMCCCollision (std::string const& collision_nam
 #endif
 }
 
-/** Calculate the maximum collision frequency using a fixed energy grid that
- *  ranges from 1e-4 to 5000 eV in 0.2 eV increments
+/** Calculate the maximum of sigma * v and the running maximum of sigma, where sigma
+ *  is the total cross-section. The running maximum is stored in bins of a fixed energy
+ *  grid that ranges from 1e-4 to 5000 eV in 0.2 eV increments (extended to the energy
+ *  range of the cross-section inputs). Since the cross-sections are piecewise linear,
+ *  both maxima are taken over the input energies of all processes (and the bin edges),
+ *  so that they are exact whatever the energy grids of the processes.
  */
-amrex::ParticleReal
-BackgroundMCCCollision::get_nu_max(amrex::Vector<ScatteringProcess> const& mcc_processes) const
+BackgroundMCCCollision::MaxSigmaVTable
+BackgroundMCCCollision::get_max_sigma_v (amrex::Vector<ScatteringProcess> const& mcc_processes) const
 {
     using namespace amrex::literals;
-    amrex::ParticleReal nu, nu_max = 0.0;
     amrex::ParticleReal E_start = 1e-4_prt;
     amrex::ParticleReal E_end = 5000._prt;
     amrex::ParticleReal E_step = 0.2_prt;
 
     // set the energy limits and step size for calculating nu_max based
-    // on the given cross-section inputs
+    // on the given cross-section inputs, and collect the input energies,
+    // at which the slope of the total cross-section changes
+    std::vector<amrex::ParticleReal> energies;
     for (const auto &process : mcc_processes) {
         auto energy_lo = process.getMinEnergyInput();
         E_start = (energy_lo < E_start) ? energy_lo : E_start;
@@ -179,31 +198,159 @@ BackgroundMCCCollision::get_nu_max(amrex::Vector<ScatteringProcess> const& mcc_p
         E_end = (energy_hi > E_end) ? energy_hi : E_end;
         auto energy_step = process.getEnergyInputStep();
         E_step = (energy_step < E_step) ? energy_step : E_step;
-    }
 
-    amrex::ParticleReal E = E_start;
-    while(E < E_end){
-        amrex::ParticleReal sigma_E = 0.0;
+        const int n = process.getNumEnergiesInput();
+        for (int i = 0; i < n; ++i) {
+            // same nodes as in ScatteringProcess::Executor::getCrossSection
+            energies.push_back((i == n - 1) ? energy_hi :
+                energy_lo + static_cast<amrex::ParticleReal>(i)*energy_step);
+        }
+    }
+    energies.push_back(E_start);
+    energies.push_back(E_end);
+    std::sort(energies.begin(), energies.end());
+    energies.erase(std::unique(energies.begin(), energies.end()), energies.end());
 
+    auto sigma = [&] (amrex::ParticleReal E) {
+        amrex::ParticleReal sigma_E = 0.0_prt;
         // loop through all collision pathways
         for (const auto &scattering_process : mcc_processes) {
-            // get collision cross-section
             sigma_E += scattering_process.getCrossSection(E);
         }
+        return sigma_E;
+    };
+    auto const v_factor = std::sqrt(2.0_prt / m_mass1 * PhysConst::q_e);
+
+    MaxSigmaVTable table;
+
+    // between two input energies, sigma is linear, and sigma * sqrt(E) is maximum
+    // at one of them or where its derivative vanishes, i.e., at E = -sigma(0) / (3 slope)
+    amrex::ParticleReal sigma_lo = sigma(energies[0]);
+    table.max_sigma_v = v_factor * sigma_lo * std::sqrt(std::max(energies[0], 0.0_prt));
+    for (std::size_t i = 1; i < energies.size(); ++i) {
+        const amrex::ParticleReal E_lo = energies[i-1];
+        const amrex::ParticleReal E_hi = energies[i];
+        const amrex::ParticleReal sigma_hi = sigma(E_hi);
+        table.max_sigma_v = std::max(table.max_sigma_v,
+            v_factor * sigma_hi * std::sqrt(std::max(E_hi, 0.0_prt)));
+        const amrex::ParticleReal slope = (sigma_hi - sigma_lo) / (E_hi - E_lo);
+        if (slope < 0.0_prt) {
+            const amrex::ParticleReal E_crit = (slope*E_lo - sigma_lo) / (3.0_prt*slope);
+            if (E_crit > E_lo && E_crit < E_hi) {
+                table.max_sigma_v = std::max(table.max_sigma_v,
+                    v_factor * sigma(E_crit) * std::sqrt(E_crit));
+            }
+        }
+        sigma_lo = sigma_hi;
+    }
 
-        // calculate collision frequency
-        nu = (
-              m_max_background_density
-              * std::sqrt(2.0_prt / m_mass1 * PhysConst::q_e)
-              * sigma_E * std::sqrt(E)
-              );
-        if (nu > nu_max) {
-            nu_max = nu;
+    // limit the memory used by the table for fine energy grids
+    auto const num_energies = std::max(1L, static_cast<long>(std::ceil((E_end - E_start) / E_step)));
+    constexpr long max_table_size = 16384;
+
+    table.energy_start = E_start;
+    table.energy_step = E_step;
+    table.stride = std::max(1L, (num_energies + max_table_size - 1) / max_table_size);
+    const long num_bins = (num_energies + table.stride - 1) / table.stride;
+    const amrex::ParticleReal bin_width = static_cast<amrex::ParticleReal>(table.stride)*E_step;
+
+    // running maximum over the input energies up to the upper edge of each bin,
+    // and at the edge itself; the last bin also covers all the remaining energies
+    amrex::ParticleReal sigma_max = 0.0_prt;
+    std::size_t i = 0;
+    for (long j = 0; j < num_bins; ++j) {
+        const amrex::ParticleReal edge = E_start + static_cast<amrex::ParticleReal>(j + 1)*bin_width;
+        while (i < energies.size() && (energies[i] <= edge || j == num_bins - 1)) {
+            sigma_max = std::max(sigma_max, sigma(energies[i]));
+            ++i;
         }
+        sigma_max = std::max(sigma_max, sigma(edge));
+        table.values.push_back(sigma_max);
+    }
+    return table;
+}
+
+amrex::ParticleReal
+BackgroundMCCCollision::MaxSigmaVTable::operator() (amrex::ParticleReal energy) const
+{
+    // values[j] covers the energies up to energy_start + (j+1)*stride*energy_step
+    auto const bin_width = static_cast<amrex::ParticleReal>(stride)*energy_step;
+    auto const k = static_cast<long>(std::floor((energy - energy_start) / bin_width));
+    auto const j = std::clamp(k, 0L, static_cast<long>(values.size()) - 1);
+    return values[j];
+}
+
+/** Calculate the maximum collision frequency from the maximum background density
+ */
+amrex::ParticleReal
+BackgroundMCCCollision::get_nu_max(amrex::Vector<ScatteringProcess> const& mcc_processes) const
+{
+    return m_max_background_density * get_max_sigma_v(mcc_processes).max_sigma_v;
+}
 
-        E+=E_step;
+amrex::ParticleReal
+BackgroundMCCCollision::get_local_nu_max (WarpXParIter& pti, amrex::Real t,
+                                          bool ionization) const
+{
+    using namespace amrex::literals;
+
+    const long np = pti.numParticles();
+    if (np == 0) { return 0.0_prt; }
+
+    auto n_a_func = m_background_density_func;
+    auto T_a_func = m_background_temperature_func;
+
+    // the scattering processes evaluate the background at the stored
+    // positions, and the ionization at the Cartesian positions
+    auto GetPosition = GetParticlePosition<PIdx>(pti);
+
+    auto& attribs = pti.GetAttribs();
+    amrex::ParticleReal const* const AMREX_RESTRICT ux = attribs[PIdx::ux].dataPtr();
+    amrex::ParticleReal const* const AMREX_RESTRICT uy = attribs[PIdx::uy].dataPtr();
+    amrex::ParticleReal const* const AMREX_RESTRICT uz = attribs[PIdx::uz].dataPtr();
+
+    amrex::ReduceOps<amrex::ReduceOpMax, amrex::ReduceOpMax, amrex::ReduceOpMax> reduce_op;
+    amrex::ReduceData<amrex::ParticleReal, amrex::ParticleReal, amrex::ParticleReal> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+    reduce_op.eval(np, reduce_data,
+        [=] AMREX_GPU_DEVICE (long ip) -> ReduceTuple
+        {
+            amrex::ParticleReal x, y, z;
+            if (ionization) {
+                GetPosition(ip, x, y, z);
+            } else {
+                GetPosition.AsStored(ip, x, y, z);
+            }
+            const amrex::ParticleReal n_a = n_a_func(x, y, z, t);
+            const amrex::ParticleReal T_a = ionization ? 0.0_prt : T_a_func(x, y, z, t);
+            const amrex::ParticleReal u2 = ux[ip]*ux[ip] + uy[ip]*uy[ip] + uz[ip]*uz[ip];
+            return {n_a, T_a, u2};
+        });
+    auto const result = reduce_data.value();
+    const amrex::ParticleReal n_max = amrex::get<0>(result);
+    const amrex::ParticleReal T_max = amrex::get<1>(result);
+    const amrex::ParticleReal u2_max = amrex::get<2>(result);
+
+    if (n_max <= 0.0_prt) { return 0.0_prt; }
+
+    // bound the relative velocity with the background, whose velocity is sampled
+    // from a Maxwellian distribution truncated at 6 thermal velocities when the
+    // local majorant is used (see doBackgroundCollisionsWithinTile)
+    amrex::ParticleReal u_max = std::sqrt(u2_max);
+    if (!ionization) {
+        u_max += 6.0_prt * std::sqrt(PhysConst::kb * std::max(T_max, 0.0_prt) / m_background_mass);
     }
-    return nu_max;
+    // the collision energy increases with the velocity, and is calculated as in
+    // the collision kernels, so that sigma is bounded by the running maximum
+    double gamma, E_max;
+    if (ionization) {
+        ParticleUtils::getEnergy(u_max*u_max, m_mass1, E_max);
+    } else {
+        ParticleUtils::getCollisionEnergy(u_max*u_max, m_mass1, m_background_mass, gamma, E_max);
+    }
+
+    auto const& table = ionization ? m_max_sigma_v_ioniz : m_max_sigma_v;
+    return n_max * table(static_cast<amrex::ParticleReal>(E_max)) * u_max;
 }
 
 void
@@ -225,7 +372,8 @@ BackgroundMCCCollision::doCollisions (amrex::Real cur_time, amrex::Real dt, Mult
         m_mass1 = species1.getMass();
 
         // calculate maximum collision frequency without ionization
-        m_nu_max = get_nu_max(m_scattering_processes);
+        m_max_sigma_v = get_max_sigma_v(m_scattering_processes);
+        m_nu_max = m_max_background_density * m_max_sigma_v.max_sigma_v;
 
         // calculate total collision probability
         auto coll_n = m_nu_max * dt;
@@ -243,7 +391,8 @@ BackgroundMCCCollision::doCollisions (amrex::Real cur_time, amrex::Real dt, Mult
 
         if (ionization_flag) {
             // calculate maximum collision frequency for ionization
-            m_nu_max_ioniz = get_nu_max(m_ionization_processes);
+            m_max_sigma_v_ioniz = get_max_sigma_v(m_ionization_processes);
+            m_nu_max_ioniz = m_max_background_density * m_max_sigma_v_ioniz.max_sigma_v;
 
             // calculate total ionization probability
             auto coll_n_ioniz = m_nu_max_ioniz * dt;
@@ -277,6 +426,7 @@ BackgroundMCCCollision::doCollisions (amrex::Real cur_time, amrex::Real dt, Mult
 
         init_flag = true;
     }
+    m_dt = dt;
 
     // Loop over refinement levels
     auto const flvl = species1.finestLevel();
@@ -332,9 +482,16 @@ void BackgroundMCCCollision::doBackgroundCollisionsWithinTile
     // get collision parameters
     auto *scattering_processes = m_scattering_processes_exe.data();
     auto const process_count  = static_cast<int>(m_scattering_processes_exe.size());
-
-    auto const total_collision_prob = m_total_collision_prob;
-    auto const nu_max = m_nu_max;
+    auto const cross_sections = m_scattering_cross_sections.executor();
+
+    auto total_collision_prob = m_total_collision_prob;
+    auto nu_max = m_nu_max;
+    const bool use_local_majorant = m_use_local_majorant;
+    if (use_local_majorant) {
+        nu_max = get_local_nu_max(pti, t, false);
+        if (nu_max <= 0.0_prt) { return; }
+        total_collision_prob = 1.0_prt - std::exp(-nu_max * m_dt);
+    }
 
     // store projectile and target masses
     auto const m = m_mass1;
@@ -372,11 +529,17 @@ void BackgroundMCCCollision::doBackgroundCollisionsWithinTile
                               amrex::ParticleReal uCOM_x, uCOM_y, uCOM_z;
                               const amrex::ParticleReal col_select = amrex::Random(engine);
 
-                              // get velocities of gas particles from a Maxwellian distribution
+                              // get velocities of gas particles from a Maxwellian distribution;
+                              // with the local majorant, it is truncated at 6 thermal velocities
+                              // (i.e., resampled with a probability of about 1e-7), so that the
+                              // majorant is an upper bound of the collision frequency
                               auto const vel_std = sqrt(PhysConst::kb * T_a / M);
-                              ua_x = vel_std * amrex::RandomNormal(0_prt, 1.0_prt, engine);
-                              ua_y = vel_std * amrex::RandomNormal(0_prt, 1.0_prt, engine);
-                              ua_z = vel_std * amrex::RandomNormal(0_prt, 1.0_prt, engine);
+                              do {
+                                  ua_x = vel_std * amrex::RandomNormal(0_prt, 1.0_prt, engine);
+                                  ua_y = vel_std * amrex::RandomNormal(0_prt, 1.0_prt, engine);
+                                  ua_z = vel_std * amrex::RandomNormal(0_prt, 1.0_prt, engine);
+                              } while (use_local_majorant &&
+                                       ua_x*ua_x + ua_y*ua_y + ua_z*ua_z > 36.0_prt*vel_std*vel_std);
 
                               // we assume the target particle is not relativistic (in
                               // the lab frame) and therefore we can transform the projectile
@@ -393,12 +556,18 @@ void BackgroundMCCCollision::doBackgroundCollisionsWithinTile
                               // calculate the collision energy in eV
                               ParticleUtils::getCollisionEnergy(v_coll2, m, M, gamma, E_coll);
 
+                              // locate the collision energy in the cross-section table,
+                              // which is shared by all collision pathways
+                              int idx_1, idx_2;
+                              amrex::ParticleReal weight;
+                              cross_sections.getIndex(static_cast<amrex::ParticleReal>(E_coll), idx_1, idx_2, weight);
+
                               // loop through all collision pathways
                               for (int i = 0; i < process_count; i++) {
                                   auto const& scattering_process = *(scattering_processes + i);
 
                                   // get collision cross-section
-                                  sigma_E = scattering_process.getCrossSection(static_cast<amrex::ParticleReal>(E_coll));
+                                  sigma_E = cross_sections.getCrossSection(idx_1, idx_2, weight, i);
 
                                   // calculate normalized collision frequency
                                   nu_i += n_a * sigma_E * v_coll / nu_max;
@@ -477,7 +646,7 @@ void BackgroundMCCCollision::doBackgroundIonization
     const auto CopyElec = copy_factory_elec.getSmartCopy();
     const auto CopyIon = copy_factory_ion.getSmartCopy();
 
-    const auto Filter = ImpactIonizationFilterFunc(
+    const auto GlobalFilter = ImpactIonizationFilterFunc(
                                                    m_ionization_processes[0],
                                                    m_mass1, m_total_collision_prob_ioniz,
                                                    m_nu_max_ioniz, m_background_density_func, t
@@ -502,6 +671,18 @@ void BackgroundMCCCollision::doBackgroundIonization
         const auto np_elec = elec_tile.numParticles();
         const auto np_ion = ion_tile.numParticles();
 
+        auto Filter = GlobalFilter;
+        if (m_use_local_majorant) {
+            using namespace amrex::literals;
+            const amrex::ParticleReal nu_max = get_local_nu_max(pti, t, true);
+            const amrex::ParticleReal total_collision_prob = 1.0_prt - std::exp(-nu_max * m_dt);
+            Filter = ImpactIonizationFilterFunc(
+                m_ionization_processes[0], m_mass1, total_collision_prob,
+                // avoid a division by zero (no particle is selected in this case)
+                (nu_max > 0.0_prt) ? nu_max : 1.0_prt,
+                m_background_density_func, t);
+        }
+
         auto Transform = ImpactIonizationTransformFunc(
                                                        m_ionization_processes[0].getEnergyPenalty(),
                                                        m_mass1, sqrt_kb_m, m_background_temperature_func, t
@@ -0,0 +1,121 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "ParticleBinCache.H"
+
+#include "Utils/ParticleUtils.H"
+#include "WarpX.H"
+
+#include <AMReX_Box.H>
+#include <AMReX_Geometry.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_Reduce.H>
+
+ParticleBinCache::TileBins&
+ParticleBinCache::getBins (WarpXParticleContainer const& species, int lev,
+                           amrex::MFIter const& mfi, ParticleTileType& ptile)
+{
+    auto const key = std::make_tuple(&species, lev, mfi.index(), mfi.LocalTileIndex());
+
+    // Insertion in the map is serialized; the entries are not moved by later insertions
+    // and each tile is only processed by one thread, so the entry can be updated freely.
+    Entry* entry = nullptr;
+#ifdef AMREX_USE_OMP
+#pragma omp critical (particle_bin_cache)
+#endif
+    {
+        entry = &m_bins[key];
+    }
+
+    auto const num_particles = static_cast<long>(ptile.numParticles());
+    if (!entry->is_valid || entry->num_particles != num_particles) {
+        TileBins& bins = entry->bins;
+        bins.is_cell_sorted = m_expect_cell_sorted &&
+            findCellOffsetsIfSorted(bins, lev, mfi, ptile);
+        if (bins.is_cell_sorted) {
+            bins.dense_bins = ParticleBins();
+        } else {
+            bins.permutation.clear();
+            bins.offsets.clear();
+            bins.dense_bins = ParticleUtils::findParticlesInEachCell(lev, mfi, ptile);
+        }
+        entry->num_particles = num_particles;
+        entry->is_valid = true;
+    }
+    return entry->bins;
+}
+
+void
+ParticleBinCache::invalidate (WarpXParticleContainer const& species)
+{
+    for (auto& [key, entry] : m_bins) {
+        if (std::get<0>(key) == &species) { entry.is_valid = false; }
+    }
+}
+
+bool
+ParticleBinCache::findCellOffsetsIfSorted (TileBins& bins, int lev,
+                                           amrex::MFIter const& mfi, ParticleTileType& ptile)
+{
+    auto const np = static_cast<index_type>(ptile.numParticles());
+    auto const ptd = ptile.getConstParticleTileData();
+
+    // Same cell indexing as ParticleUtils::findParticlesInEachCell
+    amrex::Geometry const& geom = WarpX::GetInstance().Geom(lev);
+    amrex::Box const& cbx = mfi.tilebox(amrex::IntVect::TheZeroVector()); //Cell-centered box
+    const auto lo = amrex::lbound(cbx);
+    const auto len = amrex::length(cbx);
+    const auto dxi = geom.InvCellSizeArray();
+    const auto plo = geom.ProbLoArray();
+    auto const nbins = static_cast<index_type>(cbx.numPts());
+
+    auto const cell_index = [=] AMREX_GPU_DEVICE (index_type ip) noexcept -> long
+    {
+        AMREX_D_TERM(
+            auto const i = static_cast<int>((ptd.pos(0, ip)-plo[0])*dxi[0] - lo.x);,
+            auto const j = static_cast<int>((ptd.pos(1, ip)-plo[1])*dxi[1] - lo.y);,
+            auto const k = static_cast<int>((ptd.pos(2, ip)-plo[2])*dxi[2] - lo.z);)
+        if (AMREX_D_TERM(i < 0 || i >= len.x, || j < 0 || j >= len.y, || k < 0 || k >= len.z)) {
+            return -1;
+        }
+        return AMREX_D_TERM(static_cast<long>(i), + static_cast<long>(len.x)*j,
+                            + static_cast<long>(len.x)*len.y*k);
+    };
+
+    bins.offsets.resize(nbins+1);
+    index_type* const AMREX_RESTRICT offsets = bins.offsets.dataPtr();
+
+    // Each particle fills the offsets of the cells between the cell of the previous
+    // particle (excluded) and its own cell (included); this is only consistent if the
+    // cell indices do not decrease, which is checked at the same time.
+    amrex::ReduceOps<amrex::ReduceOpSum> reduce_op;
+    amrex::ReduceData<int> reduce_data(reduce_op);
+    using ReduceTuple = typename decltype(reduce_data)::Type;
+    reduce_op.eval(np, reduce_data,
+        [=] AMREX_GPU_DEVICE (index_type ip) noexcept -> ReduceTuple
+        {
+            long const cell = cell_index(ip);
+            long const previous_cell = (ip == 0) ? -1 : cell_index(ip-1);
+            if (cell < 0 || cell < previous_cell) { return {1}; }
+            for (long c = previous_cell + 1; c <= cell; ++c) { offsets[c] = ip; }
+            if (ip == np-1) {
+                for (long c = cell + 1; c <= static_cast<long>(nbins); ++c) { offsets[c] = np; }
+            }
+            return {0};
+        });
+    int const num_unsorted = amrex::get<0>(reduce_data.value());
+    if (num_unsorted > 0) { return false; }
+    if (np == 0) {
+        amrex::ParallelFor(nbins+1, [=] AMREX_GPU_DEVICE (index_type c) noexcept { offsets[c] = 0; });
+    }
+
+    bins.permutation.resize(np);
+    index_type* const AMREX_RESTRICT permutation = bins.permutation.dataPtr();
+    amrex::ParallelFor(np, [=] AMREX_GPU_DEVICE (index_type ip) noexcept { permutation[ip] = ip; });
+    amrex::Gpu::streamSynchronize();
+
+    return true;
+}
@@ -15,6 +15,7 @@
 #include "Particles/Collision/BinaryCollision/NuclearFusion/NuclearFusionFunc.H"
 #include "Particles/Collision/BinaryCollision/ParticleCreationFunc.H"
 #include "Utils/TextMsg.H"
+#include "WarpX.H"
 
 #include <AMReX_ParmParse.H>
 
@@ -71,6 +72,8 @@ CollisionHandler::CollisionHandler(MultiParticleContainer const * const mypc)
             WARPX_ABORT_WITH_MESSAGE("Unknown collision type.");
         }
 
+        allcollisions[i]->SetBinCache(&m_bin_cache);
+
     }
 
 }
@@ -85,6 +88,16 @@ CollisionHandler::CollisionHandler(MultiParticleContainer const * const mypc)
 void CollisionHandler::doCollisions ( amrex::Real cur_time, amrex::Real dt, MultiParticleContainer* mypc)
 {
 
+    // The particles have moved since the last call: the bins are recomputed
+    // by the first collision that needs them, and reused by the following ones.
+    // If the particles were sorted by cell at the end of the previous step,
+    // the bins can be read directly from the order of the particles.
+    auto const& warpx = WarpX::GetInstance();
+    bool const sorted_by_cell = WarpX::sort_particles_for_deposition ?
+        (WarpX::sort_idx_type == amrex::IntVect::TheZeroVector()) :
+        (WarpX::sort_bin_size == amrex::IntVect::TheUnitVector());
+    m_bin_cache.clear(sorted_by_cell && WarpX::sort_intervals.contains(warpx.getistep(0)));
+
     for (auto& collision : allcollisions) {
         int const ndt = collision->get_ndt();
         if ( int(std::floor(cur_time/dt)) % ndt == 0 ) {
@@ -92,4 +105,7 @@ void CollisionHandler::doCollisions ( amrex::Real cur_time, amrex::Real dt, Mult
         }
     }
 
+    // Release the memory of the bins until the next step
+    m_bin_cache.clear();
+
 }
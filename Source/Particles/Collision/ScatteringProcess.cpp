@@ -11,6 +11,11 @@
 #include "Utils/TextMsg.H"
 #include "WarpX.H"
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <vector>
+
 ScatteringProcess::ScatteringProcess (
                         const std::string& scattering_process,
                         const std::string& cross_section_file,
@@ -125,3 +130,99 @@ ScatteringProcess::sanityCheckEnergyGrid (
                                          );
     }
 }
+
+ScatteringProcessTable::ScatteringProcessTable (amrex::Vector<ScatteringProcess> const& processes)
+{
+    using namespace amrex::literals;
+
+    const auto num_processes = static_cast<int>(processes.size());
+    if (num_processes == 0) { return; }
+
+    // common energy grid: union of the energy grids of all processes, so that the
+    // linear interpolation between its nodes is exact for every process
+    std::vector<amrex::ParticleReal> energies;
+    amrex::ParticleReal dE_min = processes[0].getEnergyInputStep();
+    bool same_grid = true;
+    for (auto const& process : processes) {
+        same_grid = same_grid &&
+            process.getNumEnergiesInput() == processes[0].getNumEnergiesInput() &&
+            process.getMinEnergyInput() == processes[0].getMinEnergyInput() &&
+            process.getMaxEnergyInput() == processes[0].getMaxEnergyInput();
+        const int n = process.getNumEnergiesInput();
+        for (int i = 0; i < n; ++i) {
+            // same nodes as in ScatteringProcess::Executor::getCrossSection
+            energies.push_back((i == n - 1) ? process.getMaxEnergyInput() :
+                process.getMinEnergyInput() + static_cast<amrex::ParticleReal>(i)*process.getEnergyInputStep());
+        }
+        if (n > 1) { dE_min = std::min(dE_min, process.getEnergyInputStep()); }
+    }
+    // merge the nodes that are closer than the tolerance of sanityCheckEnergyGrid
+    std::sort(energies.begin(), energies.end());
+    const amrex::ParticleReal tolerance = dE_min / 100.0_prt;
+    energies.erase(std::unique(energies.begin(), energies.end(),
+        [=] (amrex::ParticleReal a, amrex::ParticleReal b) { return b - a < tolerance; }),
+        energies.end());
+
+    // the indices of the table are int
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        static_cast<long>(energies.size())*num_processes <= std::numeric_limits<int>::max(),
+        "The cross-section table of the scattering processes is too large");
+
+    const auto num_energies = static_cast<int>(energies.size());
+    const amrex::ParticleReal energy_lo = energies.front();
+    const amrex::ParticleReal energy_hi = energies.back();
+    const amrex::ParticleReal dE = (num_energies > 1) ?
+        (energy_hi - energy_lo) / (num_energies - 1._prt) : 1.0_prt;
+    bool uniform = true;
+    for (int i = 1; i < num_energies; ++i) {
+        uniform = uniform && std::abs(energies[i] - energies[i-1] - dE) < dE / 100.0_prt;
+    }
+
+    m_exe_h.m_energy_lo = energy_lo;
+    m_exe_h.m_energy_hi = energy_hi;
+    m_exe_h.m_dE = dE;
+    m_exe_h.m_num_energies = num_energies;
+    m_exe_h.m_num_processes = num_processes;
+
+    m_sigmas_h.resize(static_cast<std::size_t>(num_energies)*num_processes);
+    for (int i = 0; i < num_energies; ++i) {
+        for (int p = 0; p < num_processes; ++p) {
+            // on the same grid, the input cross-sections are used as is
+            m_sigmas_h[static_cast<std::size_t>(i)*num_processes + p] = same_grid ?
+                processes[p].getCrossSectionInput(i) : processes[p].getCrossSection(energies[i]);
+        }
+    }
+    m_exe_h.m_sigmas_data = m_sigmas_h.data();
+    if (!uniform) {
+        m_energies_h.assign(energies.begin(), energies.end());
+        m_exe_h.m_energies_data = m_energies_h.data();
+        // last node at or before the lower edge of each of the num_energies - 1 uniform bins
+        m_bin_start_h.resize(num_energies - 1);
+        int i = 0;
+        for (int bin = 0; bin < num_energies - 1; ++bin) {
+            const amrex::ParticleReal edge = energy_lo + static_cast<amrex::ParticleReal>(bin)*dE;
+            while (i < num_energies - 2 && energies[i+1] <= edge) { ++i; }
+            m_bin_start_h[bin] = i;
+        }
+        m_exe_h.m_bin_start_data = m_bin_start_h.data();
+    }
+
+#ifdef AMREX_USE_GPU
+    m_exe_d = m_exe_h;
+    m_sigmas_d.resize(m_sigmas_h.size());
+    m_exe_d.m_sigmas_data = m_sigmas_d.data();
+    amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, m_sigmas_h.begin(), m_sigmas_h.end(),
+                          m_sigmas_d.begin());
+    if (!uniform) {
+        m_energies_d.resize(m_energies_h.size());
+        m_exe_d.m_energies_data = m_energies_d.data();
+        amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, m_energies_h.begin(), m_energies_h.end(),
+                              m_energies_d.begin());
+        m_bin_start_d.resize(m_bin_start_h.size());
+        m_exe_d.m_bin_start_data = m_bin_start_d.data();
+        amrex::Gpu::copyAsync(amrex::Gpu::hostToDevice, m_bin_start_h.begin(), m_bin_start_h.end(),
+                              m_bin_start_d.begin());
+    }
+    amrex::Gpu::streamSynchronize();
+#endif
+}
@@ -34,6 +34,7 @@
 #include "Particles/RigidInjectedParticleContainer.H"
 #include "Particles/WarpXParticleContainer.H"
 #include "SpeciesPhysicalProperties.H"
+#include "Utils/Algorithms/CounterBasedEngine.H"
 #include "Utils/Parser/ParserUtils.H"
 #include "Utils/TextMsg.H"
 #include "Utils/WarpXAlgorithmSelection.H"
@@ -74,8 +75,12 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <iomanip>
 #include <limits>
 #include <map>
+#include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
@@ -90,6 +95,75 @@ namespace
     {
         Array4< amrex::Real const > const Ex, Ey, Ez, Bx, By, Bz;
     };
+
+#ifdef WARPX_QED
+    /** Version of the tables stored in the QED table cache: must be incremented when
+     *  the way WarpX generates or stores the tables changes */
+    constexpr int qed_table_cache_format_version = 2;
+
+    /** Name of the file of the QED table cache that stores the table with the parameters in key
+     *  (a string that describes all the parameters of the table). The key is hashed with FNV-1a,
+     *  together with the version of the cache format and the version of PICSAR, which generates
+     *  the tables. */
+    std::string QEDTableCacheFile (std::string const& cache_dir, std::string const& prefix,
+                                   std::string const& key)
+    {
+        std::ostringstream full_key;
+        full_key << "format=" << qed_table_cache_format_version << ";"
+                 << "picsar=" << WarpX::PicsarVersion() << ";" << key;
+
+        std::uint64_t hash = 14695981039346656037ull;
+        for (char const c : full_key.str()) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        std::ostringstream ss;
+        ss << cache_dir << "/" << prefix << "_"
+           << std::hex << std::setw(16) << std::setfill('0') << hash << ".bin";
+        return ss.str();
+    }
+
+    /** Read a table from the QED table cache on all the ranks. Returns false if it is not cached. */
+    bool ReadQEDTableFromCache (std::string const& cache_file, Vector<char>& table_data)
+    {
+        int found = ParallelDescriptor::IOProcessor() ? static_cast<int>(amrex::FileExists(cache_file)) : 0;
+        ParallelDescriptor::Bcast(&found, 1, ParallelDescriptor::IOProcessorNumber());
+        if (!found) { return false; }
+        ParallelDescriptor::ReadAndBcastFile(cache_file, table_data);
+        return true;
+    }
+
+    /** Store a table in the QED table cache (on the I/O rank only) */
+    void WriteQEDTableToCache (std::string const& cache_dir, std::string const& cache_file,
+                               Vector<char> const& table_data)
+    {
+        if (!ParallelDescriptor::IOProcessor()) { return; }
+        constexpr int permission_flag_rwxrxrx = 0755;
+        if (!amrex::UtilCreateDirectory(cache_dir, permission_flag_rwxrxrx)) {
+            ablastr::warn_manager::WMRecordWarning("QED",
+                "Could not create the QED table cache directory " + cache_dir);
+            return;
+        }
+        // Write to a temporary file that is then renamed, so that concurrent runs
+        // sharing the cache never read a partially written table
+        const std::string tmp_file = cache_file + "." + amrex::UniqueString();
+        if (!WarpXUtilIO::WriteBinaryDataOnFile(tmp_file, table_data) ||
+            std::rename(tmp_file.c_str(), cache_file.c_str()) != 0) {
+            std::remove(tmp_file.c_str());
+            ablastr::warn_manager::WMRecordWarning("QED",
+                "Could not store the QED table in the cache: " + cache_file);
+        }
+    }
+
+    /** Broadcast the data of a table from the I/O rank to all the ranks */
+    void BcastQEDTableData (Vector<char>& table_data)
+    {
+        auto size = static_cast<Long>(table_data.size());
+        ParallelDescriptor::Bcast(&size, 1, ParallelDescriptor::IOProcessorNumber());
+        table_data.resize(size);
+        ParallelDescriptor::Bcast(table_data.data(), size, ParallelDescriptor::IOProcessorNumber());
+    }
+#endif
 }
 
 MultiParticleContainer::MultiParticleContainer (AmrCore* amr_core)
@@ -880,8 +954,9 @@ MultiParticleContainer::doFieldIonization (int lev,
 
     // Loop over all species.
     // Ionized particles in pc_source create particles in pc_product
-    for (auto& pc_source : allcontainers)
+    for (int isource = 0; isource < nSpecies(); ++isource)
     {
+        auto& pc_source = allcontainers[isource];
         if (!pc_source->do_field_ionization){ continue; }
 
         auto& pc_product = allcontainers[pc_source->ionization_product];
@@ -897,6 +972,9 @@ MultiParticleContainer::doFieldIonization (int lev,
 
         auto info = getMFItInfo(*pc_source, *pc_product);
 
+        auto const random_stream = utils::algorithms::CounterBasedStream::streamId(
+            "field_ionization_" + species_names[isource]);
+
 #ifdef AMREX_USE_OMP
 #pragma omp parallel if (Gpu::notInLaunchRegion())
 #endif
@@ -915,10 +993,25 @@ MultiParticleContainer::doFieldIonization (int lev,
                                                          Ex[pti], Ey[pti], Ez[pti],
                                                          Bx[pti], By[pti], Bz[pti]);
 
+            if (WarpX::use_counter_based_random) {
+                Filter.m_random_stream = utils::algorithms::CounterBasedStream(
+                    WarpX::counter_based_random_seed, random_stream,
+                    WarpX::GetInstance().getistep(lev), lev, pti.index(), pti.LocalTileIndex());
+            }
+
             const auto np_dst = dst_tile.numParticles();
+            const auto capacity_dst = dst_tile.GetStructOfArrays().GetIdCPUData().capacity();
             const auto num_added = filterCopyTransformParticles<1>(*pc_product, dst_tile, src_tile, np_dst,
                                                                    Filter, Copy, Transform);
 
+            // The tile grows geometrically when it is resized, so this should rarely happen
+            if (dst_tile.GetStructOfArrays().GetIdCPUData().capacity() != capacity_dst) {
+#ifdef AMREX_USE_OMP
+#pragma omp atomic
+#endif
+                ++(pc_source->num_ionization_product_reallocations);
+            }
+
             setNewParticleIDs(dst_tile, np_dst, num_added);
 
             if (cost && WarpX::load_balance_costs_update_algo == LoadBalanceCostsUpdateAlgo::Timers)
@@ -1137,9 +1230,6 @@ MultiParticleContainer::QuantumSyncGenerateTable ()
     const ParmParse pp_qed_qs("qed_qs");
     std::string table_name;
     pp_qed_qs.query("save_table_in", table_name);
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-        !table_name.empty(),
-        "qed_qs.save_table_in should be provided!");
 
     // qs_minimum_chi_part is the minimum chi parameter to be
     // considered for Synchrotron emission. If a lepton has chi < chi_min,
@@ -1147,71 +1237,102 @@ MultiParticleContainer::QuantumSyncGenerateTable ()
     amrex::Real qs_minimum_chi_part;
     utils::parser::getWithParser(pp_qed_qs, "chi_min", qs_minimum_chi_part);
 
-    if(ParallelDescriptor::IOProcessor()){
-        PicsarQuantumSyncCtrl ctrl;
-
-        //==Table parameters==
-
-        //--- sub-table 1 (1D)
-        //These parameters are used to pre-compute a function
-        //which appears in the evolution of the optical depth
-
-        //Minimun chi for the table. If a lepton has chi < tab_dndt_chi_min,
-        //chi is considered as if it were equal to tab_dndt_chi_min
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_dndt_chi_min", ctrl.dndt_params.chi_part_min);
-
-        //Maximum chi for the table. If a lepton has chi > tab_dndt_chi_max,
-        //chi is considered as if it were equal to tab_dndt_chi_max
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_dndt_chi_max", ctrl.dndt_params.chi_part_max);
-
-        //How many points should be used for chi in the table
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_dndt_how_many", ctrl.dndt_params.chi_part_how_many);
-        //------
-
-        //--- sub-table 2 (2D)
-        //These parameters are used to pre-compute a function
-        //which is used to extract the properties of the generated
-        //photons.
-
-        //Minimun chi for the table. If a lepton has chi < tab_em_chi_min,
-        //chi is considered as if it were equal to tab_em_chi_min
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_em_chi_min", ctrl.phot_em_params.chi_part_min);
-
-        //Maximum chi for the table. If a lepton has chi > tab_em_chi_max,
-        //chi is considered as if it were equal to tab_em_chi_max
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_em_chi_max", ctrl.phot_em_params.chi_part_max);
-
-        //How many points should be used for chi in the table
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_em_chi_how_many", ctrl.phot_em_params.chi_part_how_many);
-
-        //The other axis of the table is the ratio between the quantum
-        //parameter of the emitted photon and the quantum parameter of the
-        //lepton. This parameter is the minimum ratio to consider for the table.
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_em_frac_min", ctrl.phot_em_params.frac_min);
-
-        //This parameter is the number of different points to consider for the second
-        //axis
-        utils::parser::getWithParser(
-            pp_qed_qs, "tab_em_frac_how_many", ctrl.phot_em_params.frac_how_many);
-        //====================
+    PicsarQuantumSyncCtrl ctrl;
+
+    //==Table parameters==
+
+    //--- sub-table 1 (1D)
+    //These parameters are used to pre-compute a function
+    //which appears in the evolution of the optical depth
+
+    //Minimun chi for the table. If a lepton has chi < tab_dndt_chi_min,
+    //chi is considered as if it were equal to tab_dndt_chi_min
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_dndt_chi_min", ctrl.dndt_params.chi_part_min);
+
+    //Maximum chi for the table. If a lepton has chi > tab_dndt_chi_max,
+    //chi is considered as if it were equal to tab_dndt_chi_max
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_dndt_chi_max", ctrl.dndt_params.chi_part_max);
+
+    //How many points should be used for chi in the table
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_dndt_how_many", ctrl.dndt_params.chi_part_how_many);
+    //------
+
+    //--- sub-table 2 (2D)
+    //These parameters are used to pre-compute a function
+    //which is used to extract the properties of the generated
+    //photons.
+
+    //Minimun chi for the table. If a lepton has chi < tab_em_chi_min,
+    //chi is considered as if it were equal to tab_em_chi_min
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_em_chi_min", ctrl.phot_em_params.chi_part_min);
+
+    //Maximum chi for the table. If a lepton has chi > tab_em_chi_max,
+    //chi is considered as if it were equal to tab_em_chi_max
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_em_chi_max", ctrl.phot_em_params.chi_part_max);
+
+    //How many points should be used for chi in the table
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_em_chi_how_many", ctrl.phot_em_params.chi_part_how_many);
+
+    //The other axis of the table is the ratio between the quantum
+    //parameter of the emitted photon and the quantum parameter of the
+    //lepton. This parameter is the minimum ratio to consider for the table.
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_em_frac_min", ctrl.phot_em_params.frac_min);
+
+    //This parameter is the number of different points to consider for the second
+    //axis
+    utils::parser::getWithParser(
+        pp_qed_qs, "tab_em_frac_how_many", ctrl.phot_em_params.frac_how_many);
+    //====================
+
+    std::string cache_dir;
+    pp_qed_qs.query("table_cache_dir", cache_dir);
+    std::string cache_file;
+    if (!cache_dir.empty()) {
+        std::ostringstream key;
+        key << std::setprecision(17) << "qs;" << sizeof(amrex::ParticleReal) << ";"
+            << ctrl.dndt_params.chi_part_min << ";" << ctrl.dndt_params.chi_part_max << ";"
+            << ctrl.dndt_params.chi_part_how_many << ";"
+            << ctrl.phot_em_params.chi_part_min << ";" << ctrl.phot_em_params.chi_part_max << ";"
+            << ctrl.phot_em_params.chi_part_how_many << ";"
+            << ctrl.phot_em_params.frac_min << ";" << ctrl.phot_em_params.frac_how_many;
+        cache_file = QEDTableCacheFile(cache_dir, "qs", key.str());
+    }
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        !table_name.empty() || !cache_file.empty(),
+        "qed_qs.save_table_in or qed_qs.table_cache_dir should be provided!");
 
+    Vector<char> table_data;
+    if (!cache_file.empty() && ReadQEDTableFromCache(cache_file, table_data)) {
+        amrex::Print() << Utils::TextMsg::Info(
+            "Quantum Synchrotron table read from the cache: " + cache_file);
+        m_shr_p_qs_engine->init_lookup_tables_from_raw_data(
+            table_data, qs_minimum_chi_part);
+        if (!table_name.empty() && ParallelDescriptor::IOProcessor()) {
+            WarpXUtilIO::WriteBinaryDataOnFile(table_name, table_data);
+        }
+        return;
+    }
+
+    if(ParallelDescriptor::IOProcessor()){
         m_shr_p_qs_engine->compute_lookup_tables(ctrl, qs_minimum_chi_part);
         const auto data = m_shr_p_qs_engine->export_lookup_tables_data();
-        WarpXUtilIO::WriteBinaryDataOnFile(table_name,
-            Vector<char>{data.begin(), data.end()});
+        table_data = Vector<char>{data.begin(), data.end()};
+        if (!table_name.empty()) {
+            WarpXUtilIO::WriteBinaryDataOnFile(table_name, table_data);
+        }
+        if (!cache_file.empty()) {
+            WriteQEDTableToCache(cache_dir, cache_file, table_data);
+        }
     }
 
-    ParallelDescriptor::Barrier();
-    Vector<char> table_data;
-    ParallelDescriptor::ReadAndBcastFile(table_name, table_data);
-    ParallelDescriptor::Barrier();
+    BcastQEDTableData(table_data);
 
     //No need to initialize from raw data for the processor that
     //has just generated the table
@@ -1227,9 +1348,6 @@ MultiParticleContainer::BreitWheelerGenerateTable ()
     const ParmParse pp_qed_bw("qed_bw");
     std::string table_name;
     pp_qed_bw.query("save_table_in", table_name);
-    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
-        !table_name.empty(),
-        "qed_bw.save_table_in should be provided!");
 
     // bw_minimum_chi_phot is the minimum chi parameter to be
     // considered for pair production. If a photon has chi < chi_min,
@@ -1237,66 +1355,97 @@ MultiParticleContainer::BreitWheelerGenerateTable ()
     amrex::Real bw_minimum_chi_part;
     utils::parser::getWithParser(pp_qed_bw, "chi_min", bw_minimum_chi_part);
 
-    if(ParallelDescriptor::IOProcessor()){
-        PicsarBreitWheelerCtrl ctrl;
-
-        //==Table parameters==
-
-        //--- sub-table 1 (1D)
-        //These parameters are used to pre-compute a function
-        //which appears in the evolution of the optical depth
-
-        //Minimun chi for the table. If a photon has chi < tab_dndt_chi_min,
-        //an analytical approximation is used.
-        utils::parser::getWithParser(
-            pp_qed_bw, "tab_dndt_chi_min", ctrl.dndt_params.chi_phot_min);
-
-        //Maximum chi for the table. If a photon has chi > tab_dndt_chi_max,
-        //an analytical approximation is used.
-        utils::parser::getWithParser(
-            pp_qed_bw, "tab_dndt_chi_max", ctrl.dndt_params.chi_phot_max);
-
-        //How many points should be used for chi in the table
-        utils::parser::getWithParser(
-            pp_qed_bw, "tab_dndt_how_many", ctrl.dndt_params.chi_phot_how_many);
-        //------
-
-        //--- sub-table 2 (2D)
-        //These parameters are used to pre-compute a function
-        //which is used to extract the properties of the generated
-        //particles.
-
-        //Minimun chi for the table. If a photon has chi < tab_pair_chi_min
-        //chi is considered as it were equal to chi_phot_tpair_min
-        utils::parser::getWithParser(
-            pp_qed_bw, "tab_pair_chi_min", ctrl.pair_prod_params.chi_phot_min);
-
-        //Maximum chi for the table. If a photon has chi > tab_pair_chi_max
-        //chi is considered as it were equal to chi_phot_tpair_max
-        utils::parser::getWithParser(
-            pp_qed_bw, "tab_pair_chi_max", ctrl.pair_prod_params.chi_phot_max);
-
-        //How many points should be used for chi in the table
-        utils::parser::getWithParser(
-            pp_qed_bw, "tab_pair_chi_how_many", ctrl.pair_prod_params.chi_phot_how_many);
-
-        //The other axis of the table is the fraction of the initial energy
-        //'taken away' by the most energetic particle of the pair.
-        //This parameter is the number of different fractions to consider
-        utils::parser::getWithParser(
-            pp_qed_bw, "tab_pair_frac_how_many", ctrl.pair_prod_params.frac_how_many);
-        //====================
+    PicsarBreitWheelerCtrl ctrl;
+
+    //==Table parameters==
+
+    //--- sub-table 1 (1D)
+    //These parameters are used to pre-compute a function
+    //which appears in the evolution of the optical depth
+
+    //Minimun chi for the table. If a photon has chi < tab_dndt_chi_min,
+    //an analytical approximation is used.
+    utils::parser::getWithParser(
+        pp_qed_bw, "tab_dndt_chi_min", ctrl.dndt_params.chi_phot_min);
+
+    //Maximum chi for the table. If a photon has chi > tab_dndt_chi_max,
+    //an analytical approximation is used.
+    utils::parser::getWithParser(
+        pp_qed_bw, "tab_dndt_chi_max", ctrl.dndt_params.chi_phot_max);
+
+    //How many points should be used for chi in the table
+    utils::parser::getWithParser(
+        pp_qed_bw, "tab_dndt_how_many", ctrl.dndt_params.chi_phot_how_many);
+    //------
+
+    //--- sub-table 2 (2D)
+    //These parameters are used to pre-compute a function
+    //which is used to extract the properties of the generated
+    //particles.
+
+    //Minimun chi for the table. If a photon has chi < tab_pair_chi_min
+    //chi is considered as it were equal to chi_phot_tpair_min
+    utils::parser::getWithParser(
+        pp_qed_bw, "tab_pair_chi_min", ctrl.pair_prod_params.chi_phot_min);
+
+    //Maximum chi for the table. If a photon has chi > tab_pair_chi_max
+    //chi is considered as it were equal to chi_phot_tpair_max
+    utils::parser::getWithParser(
+        pp_qed_bw, "tab_pair_chi_max", ctrl.pair_prod_params.chi_phot_max);
+
+    //How many points should be used for chi in the table
+    utils::parser::getWithParser(
+        pp_qed_bw, "tab_pair_chi_how_many", ctrl.pair_prod_params.chi_phot_how_many);
+
+    //The other axis of the table is the fraction of the initial energy
+    //'taken away' by the most energetic particle of the pair.
+    //This parameter is the number of different fractions to consider
+    utils::parser::getWithParser(
+        pp_qed_bw, "tab_pair_frac_how_many", ctrl.pair_prod_params.frac_how_many);
+    //====================
+
+    std::string cache_dir;
+    pp_qed_bw.query("table_cache_dir", cache_dir);
+    std::string cache_file;
+    if (!cache_dir.empty()) {
+        std::ostringstream key;
+        key << std::setprecision(17) << "bw;" << sizeof(amrex::ParticleReal) << ";"
+            << ctrl.dndt_params.chi_phot_min << ";" << ctrl.dndt_params.chi_phot_max << ";"
+            << ctrl.dndt_params.chi_phot_how_many << ";"
+            << ctrl.pair_prod_params.chi_phot_min << ";" << ctrl.pair_prod_params.chi_phot_max << ";"
+            << ctrl.pair_prod_params.chi_phot_how_many << ";"
+            << ctrl.pair_prod_params.frac_how_many;
+        cache_file = QEDTableCacheFile(cache_dir, "bw", key.str());
+    }
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        !table_name.empty() || !cache_file.empty(),
+        "qed_bw.save_table_in or qed_bw.table_cache_dir should be provided!");
 
+    Vector<char> table_data;
+    if (!cache_file.empty() && ReadQEDTableFromCache(cache_file, table_data)) {
+        amrex::Print() << Utils::TextMsg::Info(
+            "Breit Wheeler table read from the cache: " + cache_file);
+        m_shr_p_bw_engine->init_lookup_tables_from_raw_data(
+            table_data, bw_minimum_chi_part);
+        if (!table_name.empty() && ParallelDescriptor::IOProcessor()) {
+            WarpXUtilIO::WriteBinaryDataOnFile(table_name, table_data);
+        }
+        return;
+    }
+
+    if(ParallelDescriptor::IOProcessor()){
         m_shr_p_bw_engine->compute_lookup_tables(ctrl, bw_minimum_chi_part);
         const auto data = m_shr_p_bw_engine->export_lookup_tables_data();
-        WarpXUtilIO::WriteBinaryDataOnFile(table_name,
-            Vector<char>{data.begin(), data.end()});
+        table_data = Vector<char>{data.begin(), data.end()};
+        if (!table_name.empty()) {
+            WarpXUtilIO::WriteBinaryDataOnFile(table_name, table_data);
+        }
+        if (!cache_file.empty()) {
+            WriteQEDTableToCache(cache_dir, cache_file, table_data);
+        }
     }
 
-    ParallelDescriptor::Barrier();
-    Vector<char> table_data;
-    ParallelDescriptor::ReadAndBcastFile(table_name, table_data);
-    ParallelDescriptor::Barrier();
+    BcastQEDTableData(table_data);
 
     //No need to initialize from raw data for the processor that
     //has just generated the table
@@ -3035,6 +3035,11 @@ PhysicalParticleContainer::InitIonizationModule ()
         charge = PhysConst::q_e;
     }
     utils::parser::queryWithParser(pp_species_name, "do_adk_correction", do_adk_correction);
+    utils::parser::queryWithParser(
+        pp_species_name, "ionization_rate_table_size", ionization_rate_table_size);
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        ionization_rate_table_size == 0 || ionization_rate_table_size >= 64,
+        "ionization_rate_table_size must be 0 (no tables) or at least 64");
 
     utils::parser::queryWithParser(
         pp_species_name, "ionization_initial_level", ionization_initial_level);
@@ -3105,6 +3110,75 @@ PhysicalParticleContainer::InitIonizationModule ()
     });
 
     Gpu::synchronize();
+
+    if (ionization_rate_table_size > 0) {
+        // Tabulate log(w(E)*dt) for each ionization level, on a log-spaced grid in E.
+        // The grid spans from the field below which the probability of ionization
+        // is negligible, to the field at which it saturates (or at which the ADK rate
+        // reaches its maximum). Outside of this range, the particles are either skipped
+        // (below) or use the analytic rate (above).
+        const int n_points = ionization_rate_table_size;
+        Vector<Real> h_adk_power(ion_atomic_number);
+        Vector<Real> h_adk_prefactor(ion_atomic_number);
+        Vector<Real> h_adk_exp_prefactor(ion_atomic_number);
+        Gpu::copy(Gpu::deviceToHost, adk_power.begin(), adk_power.end(), h_adk_power.begin());
+        Gpu::copy(Gpu::deviceToHost, adk_prefactor.begin(), adk_prefactor.end(), h_adk_prefactor.begin());
+        Gpu::copy(Gpu::deviceToHost, adk_exp_prefactor.begin(), adk_exp_prefactor.end(),
+                  h_adk_exp_prefactor.begin());
+
+        Vector<Real> h_rate_table(ion_atomic_number*n_points);
+        Vector<Real> h_emin(ion_atomic_number);
+        Vector<Real> h_emax(ion_atomic_number);
+        Vector<Real> h_inv_dlog(ion_atomic_number);
+
+        const double log_w_negligible = std::log(1.e-16);
+        const double log_w_saturated = std::log(40.);
+
+        for (int i = 0; i < ion_atomic_number; ++i) {
+            const auto log_w_dt = [&] (double E) {
+                double log_w = std::log(static_cast<double>(h_adk_prefactor[i]))
+                    + h_adk_power[i] * std::log(E) + h_adk_exp_prefactor[i] / E;
+                if (do_adk_correction) {
+                    const double r = E / table_correction_factors[3];
+                    log_w += table_correction_factors[0]*r*r + table_correction_factors[1]*r
+                        + table_correction_factors[2];
+                }
+                return log_w;
+            };
+            // Field below which log_w_dt(E) < target, by bisection on log(E);
+            // the ADK rate increases with E up to E_peak.
+            const double E_peak = h_adk_exp_prefactor[i] / h_adk_power[i];
+            const auto find_field = [&] (double target, double E_lo, double E_hi) {
+                if (log_w_dt(E_hi) <= target) { return E_hi; }
+                for (int iter = 0; iter < 100; ++iter) {
+                    const double E_mid = std::sqrt(E_lo * E_hi);
+                    if (log_w_dt(E_mid) < target) { E_lo = E_mid; } else { E_hi = E_mid; }
+                }
+                return E_lo;
+            };
+            const double E_min = find_field(log_w_negligible, 1.e-6*E_peak, E_peak);
+            const double E_max = find_field(log_w_saturated, E_min, E_peak);
+            const double dlog = std::log(E_max / E_min) / (n_points - 1);
+
+            h_emin[i] = static_cast<Real>(E_min);
+            h_emax[i] = static_cast<Real>(E_max);
+            h_inv_dlog[i] = (dlog > 0.) ? static_cast<Real>(1. / dlog) : 0._rt;
+            for (int j = 0; j < n_points; ++j) {
+                h_rate_table[i*n_points + j] = static_cast<Real>(
+                    log_w_dt(E_min * std::exp(j * dlog)));
+            }
+        }
+
+        adk_rate_table.resize(h_rate_table.size());
+        adk_table_emin.resize(ion_atomic_number);
+        adk_table_emax.resize(ion_atomic_number);
+        adk_table_inv_dlog.resize(ion_atomic_number);
+        Gpu::copyAsync(Gpu::hostToDevice, h_rate_table.begin(), h_rate_table.end(), adk_rate_table.begin());
+        Gpu::copyAsync(Gpu::hostToDevice, h_emin.begin(), h_emin.end(), adk_table_emin.begin());
+        Gpu::copyAsync(Gpu::hostToDevice, h_emax.begin(), h_emax.end(), adk_table_emax.begin());
+        Gpu::copyAsync(Gpu::hostToDevice, h_inv_dlog.begin(), h_inv_dlog.end(), adk_table_inv_dlog.begin());
+        Gpu::synchronize();
+    }
 }
 
 IonizationFilterFunc
@@ -3120,7 +3194,7 @@ PhysicalParticleContainer::getIonizationFunc (const WarpXParIter& pti,
 {
     WARPX_PROFILE("PhysicalParticleContainer::getIonizationFunc()");
 
-    return {pti, lev, ngEB, Ex, Ey, Ez, Bx, By, Bz,
+    IonizationFilterFunc filter{pti, lev, ngEB, Ex, Ey, Ez, Bx, By, Bz,
                                 m_E_external_particle, m_B_external_particle,
                                 ionization_energies.dataPtr(),
                                 adk_prefactor.dataPtr(),
@@ -3130,6 +3204,14 @@ PhysicalParticleContainer::getIonizationFunc (const WarpXParIter& pti,
                                 particle_icomps["ionizationLevel"],
                                 ion_atomic_number,
                                 do_adk_correction};
+    if (ionization_rate_table_size > 0) {
+        filter.m_adk_rate_table = adk_rate_table.dataPtr();
+        filter.m_adk_table_emin = adk_table_emin.dataPtr();
+        filter.m_adk_table_emax = adk_table_emax.dataPtr();
+        filter.m_adk_table_inv_dlog = adk_table_inv_dlog.dataPtr();
+        filter.m_adk_table_size = ionization_rate_table_size;
+    }
+    return filter;
 }
 
 PlasmaInjector* PhysicalParticleContainer::GetPlasmaInjector (int i)
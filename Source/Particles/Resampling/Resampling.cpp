@@ -8,6 +8,7 @@
 
 #include "VelocityCoincidenceThinning.H"
 #include "LevelingThinning.H"
+#include "VelocityOctreeMerging.H"
 #include "Utils/TextMsg.H"
 
 #include <AMReX.H>
@@ -27,6 +28,10 @@ Resampling::Resampling (const std::string& species_name)
     {
         m_resampling_algorithm = std::make_unique<VelocityCoincidenceThinning>(species_name);
     }
+    else if (resampling_algorithm_string == "velocity_octree_merging")
+    {
+        m_resampling_algorithm = std::make_unique<VelocityOctreeMerging>(species_name);
+    }
     else
     { WARPX_ABORT_WITH_MESSAGE("Unknown resampling algorithm."); }
 
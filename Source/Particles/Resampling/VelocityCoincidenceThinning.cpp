@@ -9,6 +9,8 @@
 
 #include "VelocityCoincidenceThinning.H"
 
+#include "ClusterMerging.H"
+
 
 VelocityCoincidenceThinning::VelocityCoincidenceThinning (const std::string& species_name)
 {
@@ -69,15 +71,6 @@ void VelocityCoincidenceThinning::operator() (WarpXParIter& pti, const int lev,
     auto& ptile = pc->ParticlesAt(lev, pti);
     const auto n_parts_in_tile = pti.numParticles();
     auto& soa = ptile.GetStructOfArrays();
-#if defined(WARPX_DIM_XZ) || defined(WARPX_DIM_3D)
-    auto * const AMREX_RESTRICT x = soa.GetRealData(PIdx::x).data();
-#elif defined(WARPX_DIM_RZ)
-    auto * const AMREX_RESTRICT x = soa.GetRealData(PIdx::x).data(); // rename to PIdx::r after PR #4667
-#endif
-#if defined(WARPX_DIM_3D)
-    auto * const AMREX_RESTRICT y = soa.GetRealData(PIdx::y).data();
-#endif
-    auto * const AMREX_RESTRICT z = soa.GetRealData(PIdx::z).data();
     auto * const AMREX_RESTRICT ux = soa.GetRealData(PIdx::ux).data();
     auto * const AMREX_RESTRICT uy = soa.GetRealData(PIdx::uy).data();
     auto * const AMREX_RESTRICT uz = soa.GetRealData(PIdx::uz).data();
@@ -109,7 +102,7 @@ void VelocityCoincidenceThinning::operator() (WarpXParIter& pti, const int lev,
     amrex::Gpu::DeviceVector<int> sorted_indices(n_parts_in_tile);
     auto* sorted_indices_data = sorted_indices.data();
 
-    constexpr auto c2 = PhysConst::c * PhysConst::c;
+    auto clusterMerging = ClusterMerging(ptile, mass);
 
     auto velocityBinCalculator = VelocityBinCalculator();
     velocityBinCalculator.velocity_grid_type = m_velocity_grid_type;
@@ -181,39 +174,15 @@ void VelocityCoincidenceThinning::operator() (WarpXParIter& pti, const int lev,
             // sort indices based on comparing values in momentum_bin_number
             heapSort(sorted_indices_data, momentum_bin_number_data, cell_start, cell_numparts);
 
-            // initialize variables used to hold cluster totals
-            int particles_in_bin = 0;
-            amrex::ParticleReal total_weight = 0._prt, total_energy = 0._prt;
-#if !defined(WARPX_DIM_1D_Z)
-            amrex::ParticleReal cluster_x = 0._prt;
-#endif
-#if defined(WARPX_DIM_3D)
-            amrex::ParticleReal cluster_y = 0._prt;
-#endif
-            amrex::ParticleReal cluster_z = 0._prt;
-            amrex::ParticleReal cluster_ux = 0._prt, cluster_uy = 0._prt, cluster_uz = 0._prt;
+            // totals of the current cluster
+            auto totals = ClusterMerging::Totals{};
 
             // Finally, loop through the particles in the cell and merge
             // ones in the same momentum bin
             for (int i = cell_start; i < cell_stop; ++i)
             {
-                particles_in_bin += 1;
                 const auto part_idx = indices[sorted_indices_data[i]];
-
-#if !defined(WARPX_DIM_1D_Z)
-                cluster_x += w[part_idx]*x[part_idx];
-#endif
-#if defined(WARPX_DIM_3D)
-                cluster_y += w[part_idx]*y[part_idx];
-#endif
-                cluster_z += w[part_idx]*z[part_idx];
-                cluster_ux += w[part_idx]*ux[part_idx];
-                cluster_uy += w[part_idx]*uy[part_idx];
-                cluster_uz += w[part_idx]*uz[part_idx];
-                total_weight += w[part_idx];
-                total_energy += w[part_idx] * Algorithms::KineticEnergy(
-                    ux[part_idx], uy[part_idx], uz[part_idx], mass
-                );
+                clusterMerging.add(totals, part_idx);
 
                 // check if this is the last particle in the current momentum bin,
                 // or if the next particle would push the current cluster weight
@@ -221,84 +190,14 @@ void VelocityCoincidenceThinning::operator() (WarpXParIter& pti, const int lev,
                 if (
                     (i == cell_stop - 1)
                     || (momentum_bin_number_data[sorted_indices_data[i]] != momentum_bin_number_data[sorted_indices_data[i + 1]])
-                    || (total_weight + w[indices[sorted_indices_data[i+1]]] > cluster_weight)
+                    || (totals.weight + w[indices[sorted_indices_data[i+1]]] > cluster_weight)
                 ) {
-                    // check if the bin has more than 2 particles in it
-                    if ( particles_in_bin > 2 && total_weight > std::numeric_limits<amrex::ParticleReal>::min() ){
-                        // get average quantities for the bin
-#if !defined(WARPX_DIM_1D_Z)
-                        cluster_x /= total_weight;
-#endif
-#if defined(WARPX_DIM_3D)
-                        cluster_y /= total_weight;
-#endif
-                        cluster_z /= total_weight;
-                        cluster_ux /= total_weight;
-                        cluster_uy /= total_weight;
-                        cluster_uz /= total_weight;
-
-                        // perform merging of momentum bin particles
-                        auto u_perp2 = cluster_ux*cluster_ux + cluster_uy*cluster_uy;
-                        auto u_perp = std::sqrt(u_perp2);
-                        auto cluster_u_mag2 = u_perp2 + cluster_uz*cluster_uz;
-                        auto cluster_u_mag = std::sqrt(cluster_u_mag2);
-
-                        // calculate required velocity magnitude to achieve
-                        // energy conservation
-                        auto v_mag2 = total_energy / total_weight * (
-                            (total_energy / total_weight + 2._prt * mass * c2 )
-                            / (mass * mass * c2)
-                        );
-                        auto v_perp = (v_mag2 > cluster_u_mag2) ? std::sqrt(v_mag2 - cluster_u_mag2) : 0_prt;
-
-                        // choose random angle for new velocity vector
-                        auto phi = amrex::Random(engine) * MathConst::pi;
-
-                        // set new velocity components based on chosen phi
-                        auto vx = v_perp * std::cos(phi);
-                        auto vy = v_perp * std::sin(phi);
-
-                        // calculate rotation angles to parallel coord. frame
-                        auto cos_theta = (cluster_u_mag > 0._prt) ? cluster_uz / cluster_u_mag : 0._prt;
-                        auto sin_theta = (cluster_u_mag > 0._prt) ? u_perp / cluster_u_mag : 0._prt;
-                        auto cos_phi = (u_perp > 0._prt) ? cluster_ux / u_perp : 0._prt;
-                        auto sin_phi = (u_perp > 0._prt) ? cluster_uy / u_perp : 0._prt;
-
-                        // rotate new velocity vector to labframe
-                        auto ux_new = (
-                            vx * cos_theta * cos_phi - vy * sin_phi
-                            + cluster_u_mag * sin_theta * cos_phi
-                        );
-                        auto uy_new = (
-                            vx * cos_theta * sin_phi + vy * cos_phi
-                            + cluster_u_mag * sin_theta * sin_phi
-                        );
-                        auto uz_new = -vx * sin_theta + cluster_u_mag * cos_theta;
-
-                        // set the last two particles' attributes according to
-                        // the bin's aggregate values
-                        const auto part_idx2 = indices[sorted_indices_data[i - 1]];
-
-                        w[part_idx] = total_weight / 2._prt;
-                        w[part_idx2] = total_weight / 2._prt;
-#if !defined(WARPX_DIM_1D_Z)
-                        x[part_idx] = cluster_x;
-                        x[part_idx2] = cluster_x;
-#endif
-#if defined(WARPX_DIM_3D)
-                        y[part_idx] = cluster_y;
-                        y[part_idx2] = cluster_y;
-#endif
-                        z[part_idx] = cluster_z;
-                        z[part_idx2] = cluster_z;
-
-                        ux[part_idx] = ux_new;
-                        uy[part_idx] = uy_new;
-                        uz[part_idx] = uz_new;
-                        ux[part_idx2] = 2._prt * cluster_ux - ux_new;
-                        uy[part_idx2] = 2._prt * cluster_uy - uy_new;
-                        uz[part_idx2] = 2._prt * cluster_uz - uz_new;
-
+                    // check if the bin has more than 2 particles in it, and
+                    // set the last two particles' attributes according to
+                    // the bin's aggregate values
+                    const auto particles_in_bin = totals.num_particles;
+                    if ( particles_in_bin > 2 &&
+                         clusterMerging.merge(totals, part_idx, indices[sorted_indices_data[i - 1]], engine) ){
                         // set ids of merged particles so they will be removed
                         for (int j = 2; j < particles_in_bin; ++j){
                             idcpu[indices[sorted_indices_data[i - j]]] = amrex::ParticleIdCpus::Invalid;
@@ -306,19 +205,7 @@ void VelocityCoincidenceThinning::operator() (WarpXParIter& pti, const int lev,
                     }
 
                     // restart the tallies
-                    particles_in_bin = 0;
-                    total_weight = 0._prt;
-                    total_energy = 0._prt;
-#if !defined(WARPX_DIM_1D_Z)
-                    cluster_x = 0_prt;
-#endif
-#if defined(WARPX_DIM_3D)
-                    cluster_y = 0_prt;
-#endif
-                    cluster_z = 0_prt;
-                    cluster_ux = 0_prt;
-                    cluster_uy = 0_prt;
-                    cluster_uz = 0_prt;
+                    totals = ClusterMerging::Totals{};
                 }
             }
         }
@@ -0,0 +1,174 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of WarpX.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+
+#include "VelocityOctreeMerging.H"
+
+#include "ClusterMerging.H"
+#include "VelocityCoincidenceThinning.H"
+#include "Particles/WarpXParticleContainer.H"
+#include "Utils/Parser/ParserUtils.H"
+#include "Utils/ParticleUtils.H"
+#include "Utils/TextMsg.H"
+
+#include <AMReX_GpuContainers.H>
+#include <AMReX_ParmParse.H>
+
+#include <limits>
+
+
+VelocityOctreeMerging::VelocityOctreeMerging (const std::string& species_name)
+{
+    const amrex::ParmParse pp_species_name(species_name);
+
+    utils::parser::queryWithParser(
+        pp_species_name, "resampling_min_ppc", m_min_ppc
+    );
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        m_min_ppc >= 1,
+        "Resampling min_ppc should be greater than or equal to 1"
+    );
+
+    utils::parser::getWithParser(
+        pp_species_name, "resampling_algorithm_target_ppc", m_target_ppc
+    );
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        m_target_ppc >= 2,
+        "Resampling target_ppc should be greater than or equal to 2"
+    );
+}
+
+void VelocityOctreeMerging::operator() (WarpXParIter& pti, const int lev,
+                                        WarpXParticleContainer * const pc) const
+{
+    using namespace amrex::literals;
+
+    auto& ptile = pc->ParticlesAt(lev, pti);
+    const auto n_parts_in_tile = pti.numParticles();
+    auto& soa = ptile.GetStructOfArrays();
+    auto * const AMREX_RESTRICT ux = soa.GetRealData(PIdx::ux).data();
+    auto * const AMREX_RESTRICT uy = soa.GetRealData(PIdx::uy).data();
+    auto * const AMREX_RESTRICT uz = soa.GetRealData(PIdx::uz).data();
+    auto * const AMREX_RESTRICT idcpu = soa.GetIdCPUData().data();
+
+    // Using this function means that we must loop over the cells in the ParallelFor.
+    auto bins = ParticleUtils::findParticlesInEachCell(lev, pti, ptile);
+
+    const auto n_cells = static_cast<int>(bins.numBins());
+    auto *const indices = bins.permutationPtr();
+    auto *const cell_offsets = bins.offsetsPtr();
+
+    const auto min_ppc = m_min_ppc;
+    const auto target_ppc = m_target_ppc;
+    const auto mass = pc->getMass();
+
+    WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+        mass > 0,
+        "VelocityOctreeMerging does not yet work for massless particles."
+    );
+
+    // Morton code of the velocity of each particle, and ordering along the Morton curve
+    amrex::Gpu::DeviceVector<int> morton_code(n_parts_in_tile);
+    auto* morton_code_data = morton_code.data();
+    amrex::Gpu::DeviceVector<int> sorted_indices(n_parts_in_tile);
+    auto* sorted_indices_data = sorted_indices.data();
+
+    auto clusterMerging = ClusterMerging(ptile, mass);
+    constexpr int n_nodes_1d = 1 << octree_depth;
+    auto heapSort = VelocityCoincidenceThinning::HeapSort();
+
+    // Loop over cells
+    amrex::ParallelForRNG( n_cells,
+        [=] AMREX_GPU_DEVICE (int i_cell, amrex::RandomEngine const& engine) noexcept
+        {
+            const auto cell_start = static_cast<int>(cell_offsets[i_cell]);
+            const auto cell_stop  = static_cast<int>(cell_offsets[i_cell+1]);
+            const auto cell_numparts = cell_stop - cell_start;
+
+            // only merge in cells with more particles than the target
+            if (cell_numparts < min_ppc || cell_numparts <= target_ppc) {
+                return;
+            }
+
+            // bounding box of the velocities in the cell, i.e., the root of the octree
+            amrex::ParticleReal u_min[3] = {std::numeric_limits<amrex::ParticleReal>::max(),
+                                            std::numeric_limits<amrex::ParticleReal>::max(),
+                                            std::numeric_limits<amrex::ParticleReal>::max()};
+            amrex::ParticleReal u_max[3] = {std::numeric_limits<amrex::ParticleReal>::lowest(),
+                                            std::numeric_limits<amrex::ParticleReal>::lowest(),
+                                            std::numeric_limits<amrex::ParticleReal>::lowest()};
+            for (int i = cell_start; i < cell_stop; ++i) {
+                const auto p = indices[i];
+                u_min[0] = amrex::min(u_min[0], ux[p]); u_max[0] = amrex::max(u_max[0], ux[p]);
+                u_min[1] = amrex::min(u_min[1], uy[p]); u_max[1] = amrex::max(u_max[1], uy[p]);
+                u_min[2] = amrex::min(u_min[2], uz[p]); u_max[2] = amrex::max(u_max[2], uz[p]);
+            }
+            amrex::ParticleReal inv_du[3];
+            for (int d = 0; d < 3; ++d) {
+                const auto du = (u_max[d] - u_min[d]) / n_nodes_1d;
+                inv_du[d] = (du > 0._prt) ? 1._prt / du : 0._prt;
+            }
+
+            // label the particles with the octree leaf containing their velocity
+            for (int i = cell_start; i < cell_stop; ++i) {
+                const auto p = indices[i];
+                const int ii = amrex::min(static_cast<int>((ux[p] - u_min[0]) * inv_du[0]), n_nodes_1d - 1);
+                const int jj = amrex::min(static_cast<int>((uy[p] - u_min[1]) * inv_du[1]), n_nodes_1d - 1);
+                const int kk = amrex::min(static_cast<int>((uz[p] - u_min[2]) * inv_du[2]), n_nodes_1d - 1);
+                morton_code_data[i] = mortonCode(ii, jj, kk);
+                sorted_indices_data[i] = i;
+            }
+
+            // depth-first ordering of the octree
+            heapSort(sorted_indices_data, morton_code_data, cell_start, cell_numparts);
+
+            // each cluster of more than 2 particles is merged into 2 particles:
+            // start from the maximum cluster size that would give target_ppc particles
+            // with full clusters, and increase it while too many particles would remain
+            int max_cluster_size = amrex::max(3, (2*cell_numparts + target_ppc - 1) / target_ppc);
+            for (int iter = 0; iter < max_iterations; ++iter) {
+                int n_remaining = 0;
+                for (int i = cell_start; i < cell_stop; ) {
+                    const int cluster_stop = clusterStop(
+                        morton_code_data, sorted_indices_data, i, cell_stop, max_cluster_size);
+                    n_remaining += amrex::min(cluster_stop - i, 2);
+                    i = cluster_stop;
+                }
+                if (n_remaining <= target_ppc) { break; }
+                max_cluster_size = static_cast<int>(amrex::max(
+                    static_cast<amrex::Long>(max_cluster_size) + 1,
+                    (static_cast<amrex::Long>(max_cluster_size)*n_remaining + target_ppc - 1) / target_ppc));
+            }
+
+            int i = cell_start;
+            while (i < cell_stop)
+            {
+                const int cluster_stop = clusterStop(
+                    morton_code_data, sorted_indices_data, i, cell_stop, max_cluster_size);
+                const int cluster_size = cluster_stop - i;
+
+                if (cluster_size > 2)
+                {
+                    auto totals = ClusterMerging::Totals{};
+                    for (int k = i; k < cluster_stop; ++k) {
+                        clusterMerging.add(totals, indices[sorted_indices_data[k]]);
+                    }
+
+                    // the first two particles of the cluster are kept,
+                    // and the other particles of the cluster are removed
+                    if (clusterMerging.merge(totals, indices[sorted_indices_data[i]],
+                                             indices[sorted_indices_data[i + 1]], engine)) {
+                        for (int k = i + 2; k < cluster_stop; ++k) {
+                            idcpu[indices[sorted_indices_data[k]]] = amrex::ParticleIdCpus::Invalid;
+                        }
+                    }
+                }
+
+                i = cluster_stop;
+            }
+        }
+    );
+}
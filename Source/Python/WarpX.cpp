@@ -87,6 +87,18 @@ void init_WarpX (py::module& m)
         .def("evolve", &WarpX::Evolve,
             "Evolve the simulation the specified number of steps"
         )
+        .def("save_memory_checkpoint", &WarpX::SaveMemoryCheckpoint,
+            "Copy the fields, particles and time-stepping state to host memory"
+        )
+        .def("restore_memory_checkpoint", &WarpX::RestoreMemoryCheckpoint,
+            py::arg("from_partner") = false,
+            "Roll the simulation back to the last in-memory checkpoint.\n"
+            "With from_partner=True, the data of each MPI rank are restored from the copy "
+            "held by its partner rank (requires warpx.memory_checkpoint_mirror)."
+        )
+        .def_property_readonly("has_memory_checkpoint", &WarpX::HasMemoryCheckpoint,
+            "Whether an in-memory checkpoint is available"
+        )
 
         // from amrex::AmrCore / amrex::AmrMesh
         .def_property_readonly("max_level",
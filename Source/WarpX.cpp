@@ -12,6 +12,7 @@
 #include "WarpX.H"
 
 #include "BoundaryConditions/PML.H"
+#include "Diagnostics/MemoryCheckpoint.H"
 #include "Diagnostics/MultiDiagnostics.H"
 #include "Diagnostics/ReducedDiags/MultiReducedDiags.H"
 #include "EmbeddedBoundary/Enabled.H"
@@ -53,6 +54,7 @@
 #ifdef AMREX_USE_SENSEI_INSITU
 #   include <AMReX_AmrMeshInSituBridge.H>
 #endif
+#include <AMReX.H>
 #include <AMReX_Array4.H>
 #include <AMReX_BLassert.H>
 #include <AMReX_Box.H>
@@ -101,6 +103,7 @@ int WarpX::moving_window_dir = -1;
 Real WarpX::moving_window_v = std::numeric_limits<amrex::Real>::max();
 
 bool WarpX::fft_do_time_averaging = false;
+bool WarpX::fft_do_mixed_precision = false;
 
 amrex::IntVect WarpX::m_fill_guards_fields  = amrex::IntVect(0);
 amrex::IntVect WarpX::m_fill_guards_current = amrex::IntVect(0);
@@ -175,6 +178,9 @@ bool WarpX::sort_particles_for_deposition = false;
 
 amrex::IntVect WarpX::sort_idx_type(AMREX_D_DECL(0,0,0));
 
+bool WarpX::use_counter_based_random = false;
+std::uint64_t WarpX::counter_based_random_seed = 1;
+
 bool WarpX::do_dynamic_scheduling = true;
 
 bool WarpX::do_subcycling = false;
@@ -195,6 +201,12 @@ amrex::IntVect m_rho_nodal_flag;
 
 WarpX* WarpX::m_instance = nullptr;
 
+namespace
+{
+    //! AMReX error handler before WarpX::AbortHandler was installed
+    amrex::ErrorHandler previous_error_handler = nullptr;
+}
+
 void WarpX::MakeWarpX ()
 {
     ParseGeometryInput();
@@ -237,6 +249,19 @@ WarpX::Finalize()
     WarpX::ResetInstance();
 }
 
+void
+WarpX::AbortHandler (const char* msg)
+{
+    // Restore the previous handler first, so that an error while writing aborts directly
+    amrex::system::error_handler = previous_error_handler;
+
+    if (m_instance && m_instance->reduced_diags && m_instance->reduced_diags->m_plot_rd != 0) {
+        m_instance->reduced_diags->FlushBuffers();
+    }
+
+    amrex::Abort(msg);
+}
+
 WarpX::WarpX ()
 {
     ReadParameters();
@@ -247,6 +272,10 @@ WarpX::WarpX ()
 
     ablastr::utils::SignalHandling::InitSignalHandling();
 
+    // Write the buffered reduced diagnostics when aborting
+    previous_error_handler = amrex::system::error_handler;
+    amrex::system::error_handler = &WarpX::AbortHandler;
+
     // Geometry on all levels has been defined already.
     // No valid BoxArray and DistributionMapping have been defined.
     // But the arrays for them have been resized.
@@ -440,6 +469,8 @@ WarpX::WarpX ()
 
 WarpX::~WarpX ()
 {
+    amrex::system::error_handler = previous_error_handler;
+
     const int nlevs_max = maxLevel() +1;
     for (int lev = 0; lev < nlevs_max; ++lev) {
         ClearLevel(lev);
@@ -583,18 +614,25 @@ WarpX::ReadParameters ()
                 const unsigned long cpu_seed = myproc_1 * dist(rd);
                 const unsigned long gpu_seed = myproc_1 * dist(rd);
                 ResetRandomSeed(cpu_seed, gpu_seed);
+                // the counter-based random numbers use the same seed on all MPI ranks
+                unsigned long counter_based_seed = std::uniform_int_distribution<unsigned long>()(rd);
+                ParallelDescriptor::Bcast(&counter_based_seed, 1, ParallelDescriptor::IOProcessorNumber());
+                counter_based_random_seed = counter_based_seed;
             } else if ( std::stoi(random_seed) > 0 ) {
                 const unsigned long nprocs = ParallelDescriptor::NProcs();
                 const unsigned long seed_long = std::stoul(random_seed);
                 const unsigned long cpu_seed = myproc_1 * seed_long;
                 const unsigned long gpu_seed = (myproc_1 + nprocs) * seed_long;
                 ResetRandomSeed(cpu_seed, gpu_seed);
+                counter_based_random_seed = seed_long;
             } else {
                 WARPX_ABORT_WITH_MESSAGE(
                     "warpx.random_seed must be \"default\", \"random\" or an integer > 0.");
             }
         }
 
+        pp_warpx.query("counter_based_random", use_counter_based_random);
+
         utils::parser::queryWithParser(pp_warpx, "cfl", cfl);
         pp_warpx.query("verbose", verbose);
         utils::parser::queryWithParser(pp_warpx, "regrid_int", regrid_int);
@@ -912,8 +950,26 @@ WarpX::ReadParameters ()
             utils::parser::queryWithParser(pp_warpx, "particle_io_nfiles", particle_io_nfiles);
             ParmParse pp_particles("particles");
             pp_particles.add("particles_nfiles", particle_io_nfiles);
+            // Do not override particles.nreaders (read by AMReX) when it is set directly
+            if (utils::parser::queryWithParser(pp_warpx, "particle_io_nreaders", particle_io_nreaders)) {
+                WARPX_ALWAYS_ASSERT_WITH_MESSAGE(particle_io_nreaders >= 1,
+                    "warpx.particle_io_nreaders must be at least 1");
+                if (!pp_particles.contains("nreaders")) {
+                    pp_particles.add("nreaders", particle_io_nreaders);
+                }
+            }
+            utils::parser::queryWithParser(pp_warpx, "io_aggregation_factor", io_aggregation_factor);
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(io_aggregation_factor >= 1,
+                "warpx.io_aggregation_factor must be at least 1");
         }
 
+        // In-memory checkpoints
+        std::vector<std::string> memory_checkpoint_intervals_string_vec = {"0"};
+        pp_warpx.queryarr("memory_checkpoint_intervals", memory_checkpoint_intervals_string_vec);
+        m_memory_checkpoint_intervals = utils::parser::IntervalsParser(
+            memory_checkpoint_intervals_string_vec);
+        pp_warpx.query("memory_checkpoint_mirror", m_memory_checkpoint_mirror);
+
         if (maxLevel() > 0) {
             Vector<Real> lo, hi;
             const bool fine_tag_lo_specified = utils::parser::queryArrWithParser(pp_warpx, "fine_tag_lo", lo);
@@ -1477,6 +1533,22 @@ WarpX::ReadParameters ()
 
         pp_psatd.query("do_time_averaging", fft_do_time_averaging);
 
+        pp_psatd.query("do_mixed_precision", fft_do_mixed_precision);
+#ifdef AMREX_USE_FLOAT
+        if (fft_do_mixed_precision) {
+            fft_do_mixed_precision = false;
+            ablastr::warn_manager::WMRecordWarning(
+                "Algorithms",
+                "Overwrote psatd.do_mixed_precision to be 0, since WarpX was built in single precision.",
+                ablastr::warn_manager::WarnPriority::low);
+        }
+#endif
+#ifdef WARPX_DIM_RZ
+        WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+            !fft_do_mixed_precision,
+            "psatd.do_mixed_precision=1 is not implemented in RZ geometry");
+#endif
+
         if (WarpX::current_deposition_algo == CurrentDepositionAlgo::Vay)
         {
             WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
@@ -1491,6 +1563,17 @@ WarpX::ReadParameters ()
                 "Options algo.current_deposition=vay and psatd.current_correction=1 cannot be combined together.");
         }
 
+        pp_psatd.query("spectral_resident_current", m_psatd_spectral_resident_current);
+        if (m_psatd_spectral_resident_current)
+        {
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                fft_periodic_single_box && current_correction,
+                "psatd.spectral_resident_current=1 requires psatd.periodic_single_box_fft=1 and psatd.current_correction=1");
+            WARPX_ALWAYS_ASSERT_WITH_MESSAGE(
+                !do_moving_window,
+                "psatd.spectral_resident_current=1 is not implemented with a moving window");
+        }
+
         // Auxiliary: boosted_frame = true if WarpX::gamma_boost is set in the inputs
         const amrex::ParmParse pp_warpx("warpx");
         const bool boosted_frame = pp_warpx.query("gamma_boost", gamma_boost);
@@ -2805,7 +2888,8 @@ void WarpX::AllocLevelSpectralSolver (amrex::Vector<std::unique_ptr<SpectralSolv
                                                 J_in_time,
                                                 rho_in_time,
                                                 do_dive_cleaning,
-                                                do_divb_cleaning);
+                                                do_divb_cleaning,
+                                                fft_do_mixed_precision);
     spectral_solver[lev] = std::move(pss);
 }
 #   endif
@@ -9,7 +9,9 @@
 #include "ablastr/utils/TextMsg.H"
 
 #include <AMReX_BLProfiler.H>
+#include <AMReX_Box.H>
 #include <AMReX_BoxArray.H>
+#include <AMReX_BoxList.H>
 #include <AMReX_Config.H>
 #include <AMReX_DistributionMapping.H>
 #include <AMReX_FArrayBox.H>
@@ -20,16 +22,24 @@
 #include <AMReX_IntVect.H>
 #include <AMReX_MFIter.H>
 #include <AMReX_MultiFab.H>
+#include <AMReX_Vector.H>
 
 #include <memory>
+#include <utility>
 
 
-namespace ablastr::coarsen::sample
+namespace
 {
+    /**
+     * \brief Same as ablastr::coarsen::sample::Loop, where the box of index
+     *        \c src_index[K] of \c mf_src (or K if \c src_index is empty) is the source
+     *        of the box of index K of \c mf_dst, and is owned by the same MPI rank.
+     */
     void
-    Loop (
+    LoopImpl (
         amrex::MultiFab& mf_dst,
         const amrex::MultiFab& mf_src,
+        const amrex::Vector<int>& src_index,
         const int dcomp,
         const int scomp,
         const int ncomp,
@@ -37,6 +47,8 @@ namespace ablastr::coarsen::sample
         const amrex::IntVect crse_ratio
     )
     {
+        using namespace ablastr::coarsen::sample;
+
         // Staggering of source fine MultiFab and destination coarse MultiFab
         const amrex::IntVect stag_src = mf_src.boxArray().ixType().toIntVect();
         const amrex::IntVect stag_dst = mf_dst.boxArray().ixType().toIntVect();
@@ -69,7 +81,8 @@ namespace ablastr::coarsen::sample
             // Tiles defined at the coarse level
             const amrex::Box& bx = mfi.growntilebox( ngrowvect );
             amrex::Array4<amrex::Real> const& arr_dst = mf_dst.array( mfi );
-            amrex::Array4<amrex::Real const> const& arr_src = mf_src.const_array( mfi );
+            amrex::Array4<amrex::Real const> const& arr_src = src_index.empty() ?
+                mf_src.const_array( mfi ) : mf_src.const_array( src_index[mfi.index()] );
             ParallelFor( bx, ncomp,
                          [=] AMREX_GPU_DEVICE( int i, int j, int k, int n )
                          {
@@ -78,6 +91,23 @@ namespace ablastr::coarsen::sample
                          } );
         }
     }
+}
+
+namespace ablastr::coarsen::sample
+{
+    void
+    Loop (
+        amrex::MultiFab& mf_dst,
+        const amrex::MultiFab& mf_src,
+        const int dcomp,
+        const int scomp,
+        const int ncomp,
+        const amrex::IntVect ngrowvect,
+        const amrex::IntVect crse_ratio
+    )
+    {
+        LoopImpl( mf_dst, mf_src, amrex::Vector<int>{}, dcomp, scomp, ncomp, ngrowvect, crse_ratio );
+    }
 
     void
     Coarsen (
@@ -124,10 +154,27 @@ namespace ablastr::coarsen::sample
         } else
         {
             // Cannot coarsen into MultiFab with different BoxArray or DistributionMapping:
-            // 1) create temporary MultiFab on coarsened version of source BoxArray with same DistributionMapping
-            amrex::MultiFab mf_tmp( ba_tmp, mf_src.DistributionMap(), ncomp, ngrowvect, amrex::MFInfo(), amrex::FArrayBoxFactory() );
+            // 1) create temporary MultiFab on coarsened version of source BoxArray with same DistributionMapping,
+            //    keeping only the part of each box that overlaps with mf_dst, so that the temporary data
+            //    scales with the destination (e.g., a small diagnostics domain) rather than with the source
+            const amrex::Box dst_region = amrex::grow( mf_dst.boxArray().minimalBox(), ngrowvect );
+            amrex::BoxList bl_tmp( mf_dst.ixType() );
+            amrex::Vector<int> pmap_tmp;
+            amrex::Vector<int> src_index;
+            for (int i = 0; i < static_cast<int>(ba_tmp.size()); ++i) {
+                const amrex::Box bx = ba_tmp[i] & dst_region;
+                if (bx.ok()) {
+                    bl_tmp.push_back( bx );
+                    pmap_tmp.push_back( mf_src.DistributionMap()[i] );
+                    src_index.push_back( i );
+                }
+            }
+            if (src_index.empty()) { return; }
+            const amrex::BoxArray ba_clip( std::move(bl_tmp) );
+            const amrex::DistributionMapping dm_clip( std::move(pmap_tmp) );
+            amrex::MultiFab mf_tmp( ba_clip, dm_clip, ncomp, ngrowvect, amrex::MFInfo(), amrex::FArrayBoxFactory() );
             // 2) interpolate from mf_src to mf_tmp (start writing into component 0)
-            Loop( mf_tmp, mf_src, 0, scomp, ncomp, ngrowvect, crse_ratio );
+            LoopImpl( mf_tmp, mf_src, src_index, 0, scomp, ncomp, ngrowvect, crse_ratio );
             // 3) copy from mf_tmp to mf_dst (with different BoxArray or DistributionMapping)
             mf_dst.ParallelCopy( mf_tmp, 0, dcomp, ncomp );
         }
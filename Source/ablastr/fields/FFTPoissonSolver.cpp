@@ -0,0 +1,188 @@
+/* Copyright 2024 The WarpX Community
+ *
+ * This file is part of ABLASTR.
+ *
+ * License: BSD-3-Clause-LBNL
+ */
+#include "FFTPoissonSolver.H"
+
+#include <ablastr/constant.H>
+#include <ablastr/math/fft/AnyFFT.H>
+#include <ablastr/utils/TextMsg.H>
+
+#include <AMReX_Array.H>
+#include <AMReX_Array4.H>
+#include <AMReX_BaseFab.H>
+#include <AMReX_BLProfiler.H>
+#include <AMReX_Box.H>
+#include <AMReX_BoxArray.H>
+#include <AMReX_DistributionMapping.H>
+#include <AMReX_FArrayBox.H>
+#include <AMReX_GpuComplex.H>
+#include <AMReX_GpuDevice.H>
+#include <AMReX_GpuLaunch.H>
+#include <AMReX_GpuQualifiers.H>
+#include <AMReX_IntVect.H>
+#include <AMReX_MFIter.H>
+#include <AMReX_MultiFab.H>
+#include <AMReX_REAL.H>
+#include <AMReX_Vector.H>
+
+#include <cmath>
+
+
+namespace ablastr::fields {
+
+void
+computePhiFFTPeriodic (amrex::MultiFab const & rho,
+                       amrex::MultiFab & phi,
+                       amrex::Geometry const & geom,
+                       int const dirichlet_dir)
+{
+    using namespace amrex::literals;
+
+    BL_PROFILE("ablastr::fields::computePhiFFTPeriodic");
+
+    ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE(dirichlet_dir < AMREX_SPACEDIM,
+        "computePhiFFTPeriodic: invalid Dirichlet direction");
+
+    // Nodal box of the domain. Along the periodic directions, the last node is
+    // the periodic image of the first one and is excluded from the FFT.
+    // Along the Dirichlet direction, the FFT is done on the odd extension of
+    // rho over twice the domain length.
+    amrex::Box domain = geom.Domain();
+    domain.surroundingNodes();
+    amrex::Box gather_box = domain;
+    amrex::IntVect const ncell = geom.Domain().length();
+    amrex::IntVect fft_size = ncell;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        if (idim == dirichlet_dir) {
+            fft_size[idim] = 2*ncell[idim];
+        } else {
+            gather_box.growHi(idim, -1);
+        }
+    }
+    amrex::IntVect const lo = domain.smallEnd();
+
+    // Gather rho, and phi for its boundary values, in a single box on rank 0
+    amrex::BoxArray const gather_ba(gather_box);
+    amrex::DistributionMapping const gather_dm(amrex::Vector<int>{0});
+    amrex::MultiFab rho_global(gather_ba, gather_dm, 1, 0);
+    rho_global.ParallelCopy(rho, 0, 0, 1);
+    amrex::MultiFab phi_global(gather_ba, gather_dm, 1, 0);
+    if (dirichlet_dir >= 0) {
+        phi_global.ParallelCopy(phi, 0, 0, 1);
+    }
+
+    // Coefficients of the eigenvalues of the discrete Laplacian
+    amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> coef;
+    amrex::GpuArray<amrex::Real, AMREX_SPACEDIM> dtheta;
+    for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+        amrex::Real const dx = geom.CellSize(idim);
+        coef[idim] = 2._rt / (dx*dx);
+        dtheta[idim] = 2._rt * ablastr::constant::math::pi / fft_size[idim];
+    }
+
+    for (amrex::MFIter mfi(rho_global); mfi.isValid(); ++mfi) {
+
+        amrex::Box const real_box(amrex::IntVect(0), fft_size - 1);
+        amrex::Box spectral_box = real_box;
+        spectral_box.setBig(0, fft_size[0]/2);
+
+        amrex::FArrayBox tmp_real(real_box, 1, amrex::The_Device_Arena());
+        amrex::BaseFab<amrex::GpuComplex<amrex::Real>> tmp_spectral(
+            spectral_box, 1, amrex::The_Device_Arena());
+
+        amrex::Array4<amrex::Real const> const rho_arr = rho_global.const_array(mfi);
+        amrex::Array4<amrex::Real> const real_arr = tmp_real.array();
+        amrex::Array4<amrex::GpuComplex<amrex::Real>> const spectral_arr = tmp_spectral.array();
+
+        // Fill the source, with the odd extension along the Dirichlet direction
+        amrex::ParallelFor(real_box,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                amrex::IntVect iv(AMREX_D_DECL(i,j,k));
+                amrex::Real sign = 1._rt;
+                if (dirichlet_dir >= 0) {
+                    int const n = ncell[dirichlet_dir];
+                    if (iv[dirichlet_dir] == 0 || iv[dirichlet_dir] == n) {
+                        real_arr(i,j,k) = 0._rt;
+                        return;
+                    }
+                    if (iv[dirichlet_dir] > n) {
+                        iv[dirichlet_dir] = 2*n - iv[dirichlet_dir];
+                        sign = -1._rt;
+                    }
+                }
+                real_arr(i,j,k) = sign * rho_arr(iv + lo);
+            });
+
+        ablastr::math::anyfft::FFTplan forward_plan = ablastr::math::anyfft::CreatePlan(
+            fft_size, tmp_real.dataPtr(),
+            reinterpret_cast<ablastr::math::anyfft::Complex*>(tmp_spectral.dataPtr()),
+            ablastr::math::anyfft::direction::R2C, AMREX_SPACEDIM);
+        ablastr::math::anyfft::FFTplan backward_plan = ablastr::math::anyfft::CreatePlan(
+            fft_size, tmp_real.dataPtr(),
+            reinterpret_cast<ablastr::math::anyfft::Complex*>(tmp_spectral.dataPtr()),
+            ablastr::math::anyfft::direction::C2R, AMREX_SPACEDIM);
+
+        ablastr::math::anyfft::Execute(forward_plan);
+
+        // Divide by the eigenvalues of the discrete Laplacian, -lambda:
+        // -lambda phi = -rho/ep0. This includes the normalization of the FFTs.
+        amrex::Real const norm = 1._rt /
+            (ablastr::constant::SI::ep0 * static_cast<amrex::Real>(real_box.numPts()));
+        amrex::ParallelFor(spectral_box,
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                amrex::IntVect const iv(AMREX_D_DECL(i,j,k));
+                amrex::Real lambda = 0._rt;
+                for (int idim = 0; idim < AMREX_SPACEDIM; ++idim) {
+                    lambda += coef[idim] * (1._rt - std::cos(dtheta[idim]*iv[idim]));
+                }
+                if (lambda == 0._rt) {
+                    // Mean value (fully periodic case)
+                    spectral_arr(i,j,k) = amrex::GpuComplex<amrex::Real>{0._rt, 0._rt};
+                } else {
+                    spectral_arr(i,j,k) = spectral_arr(i,j,k) * (norm / lambda);
+                }
+            });
+
+        ablastr::math::anyfft::Execute(backward_plan);
+
+        // Copy the solution, and add the linear potential that matches the
+        // boundary values of phi along the Dirichlet direction
+        amrex::Array4<amrex::Real> const phi_arr = phi_global.array(mfi);
+        amrex::ParallelFor(mfi.validbox(),
+            [=] AMREX_GPU_DEVICE (int i, int j, int k) noexcept
+            {
+                amrex::IntVect const iv(AMREX_D_DECL(i,j,k));
+                amrex::IntVect const ie = iv - lo;
+                if (dirichlet_dir < 0) {
+                    phi_arr(iv) = real_arr(ie);
+                    return;
+                }
+                int const n = ncell[dirichlet_dir];
+                // The boundary nodes keep their values
+                if (ie[dirichlet_dir] == 0 || ie[dirichlet_dir] == n) { return; }
+                amrex::IntVect iv_lo = iv;
+                amrex::IntVect iv_hi = iv;
+                iv_lo[dirichlet_dir] = lo[dirichlet_dir];
+                iv_hi[dirichlet_dir] = lo[dirichlet_dir] + n;
+                amrex::Real const phi_lo = phi_arr(iv_lo);
+                amrex::Real const phi_hi = phi_arr(iv_hi);
+                phi_arr(iv) = real_arr(ie)
+                    + phi_lo + (phi_hi - phi_lo) * static_cast<amrex::Real>(ie[dirichlet_dir]) / n;
+            });
+
+        amrex::Gpu::streamSynchronize();
+
+        ablastr::math::anyfft::DestroyPlan(forward_plan);
+        ablastr::math::anyfft::DestroyPlan(backward_plan);
+    }
+
+    // Scatter phi, including the periodic images and the guard cells
+    phi.ParallelCopy(phi_global, 0, 0, 1, amrex::IntVect(0), phi.nGrowVect(), geom.periodicity());
+}
+
+} // namespace ablastr::fields
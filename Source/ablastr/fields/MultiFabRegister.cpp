@@ -536,6 +536,17 @@ namespace ablastr::fields
         return names;
     }
 
+    std::vector<std::string>
+    MultiFabRegister::list_owned () const
+    {
+        std::vector<std::string> names;
+        for (auto const & str : m_mf_register) {
+            if (!str.second.is_alias()) { names.push_back(str.first); }
+        }
+
+        return names;
+    }
+
     void
     MultiFabRegister::internal_erase (
         std::string const & name,
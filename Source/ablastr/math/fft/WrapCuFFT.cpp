@@ -110,6 +110,69 @@ namespace ablastr::math::anyfft
         }
     }
 
+#ifdef ABLASTR_FFT_MIXED_PRECISION
+    FFTplanSingle CreatePlanSingle(const amrex::IntVect& real_size, float * const real_array,
+                                   ComplexSingle * const complex_array, const direction dir, const int dim)
+    {
+        FFTplanSingle fft_plan;
+        ABLASTR_PROFILE("ablastr::math::anyfft::CreatePlanSingle");
+
+        // Initialize fft_plan.m_plan with the vendor fft plan.
+        const cufftType vendor_type = (dir == direction::R2C) ? CUFFT_R2C : CUFFT_C2R;
+        cufftResult result;
+        if (dim == 3) {
+            result = cufftPlan3d(
+                &(fft_plan.m_plan), real_size[2], real_size[1], real_size[0], vendor_type);
+        } else if (dim == 2) {
+            result = cufftPlan2d(
+                &(fft_plan.m_plan), real_size[1], real_size[0], vendor_type);
+        } else if (dim == 1) {
+            result = cufftPlan1d(
+                &(fft_plan.m_plan), real_size[0], vendor_type, 1);
+        } else {
+            ABLASTR_ABORT_WITH_MESSAGE("only dim=1 and dim=2 and dim=3 have been implemented");
+        }
+
+        ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE(result == CUFFT_SUCCESS,
+            "cufftplan failed! Error: " + cufftErrorToString(result));
+
+        // Store meta-data in fft_plan
+        fft_plan.m_real_array = real_array;
+        fft_plan.m_complex_array = complex_array;
+        fft_plan.m_dir = dir;
+        fft_plan.m_dim = dim;
+
+        return fft_plan;
+    }
+
+    void DestroyPlan(FFTplanSingle& fft_plan)
+    {
+        ABLASTR_PROFILE("ablastr::math::anyfft::DestroyPlan");
+        cufftDestroy( fft_plan.m_plan );
+    }
+
+    void Execute(FFTplanSingle& fft_plan){
+        ABLASTR_PROFILE("ablastr::math::anyfft::Execute");
+        // make sure that this is done on the same GPU stream as the above copy
+        cudaStream_t stream = amrex::Gpu::Device::cudaStream();
+        cufftSetStream ( fft_plan.m_plan, stream);
+        cufftResult result;
+        if (fft_plan.m_dir == direction::R2C){
+            result = cufftExecR2C(fft_plan.m_plan, fft_plan.m_real_array, fft_plan.m_complex_array);
+        } else if (fft_plan.m_dir == direction::C2R){
+            result = cufftExecC2R(fft_plan.m_plan, fft_plan.m_complex_array, fft_plan.m_real_array);
+        } else {
+            ABLASTR_ABORT_WITH_MESSAGE(
+                "direction must be FFTplan::direction::R2C or FFTplan::direction::C2R");
+        }
+        if ( result != CUFFT_SUCCESS ) {
+            ABLASTR_ABORT_WITH_MESSAGE(
+                "forward transform using cufftExec failed ! Error: "
+                +cufftErrorToString(result));
+        }
+    }
+#endif
+
     /** \brief This method converts a cufftResult
      * into the corresponding string
      *
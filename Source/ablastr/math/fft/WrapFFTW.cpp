@@ -108,4 +108,67 @@ namespace ablastr::math::anyfft
         fftw_execute( fft_plan.m_plan );
 #  endif
     }
+
+#ifdef ABLASTR_FFT_MIXED_PRECISION
+    FFTplanSingle CreatePlanSingle(const amrex::IntVect& real_size, float * const real_array,
+                                   ComplexSingle * const complex_array, const direction dir, const int dim)
+    {
+        FFTplanSingle fft_plan;
+
+        // In double-precision builds, the threaded single-precision library is linked separately
+#if defined(AMREX_USE_OMP) && ((defined(WarpX_FFTW_OMP) && defined(AMREX_USE_FLOAT)) || defined(ABLASTR_FFTW_SINGLE_OMP))
+        fftwf_init_threads();
+        fftwf_plan_with_nthreads(omp_get_max_threads());
+#endif
+
+        // Initialize fft_plan.m_plan with the vendor fft plan.
+        // Swap dimensions: AMReX FAB are Fortran-order but FFTW is C-order
+        if (dir == direction::R2C){
+            if (dim == 3) {
+                fft_plan.m_plan = fftwf_plan_dft_r2c_3d(
+                    real_size[2], real_size[1], real_size[0], real_array, complex_array, FFTW_ESTIMATE);
+            } else if (dim == 2) {
+                fft_plan.m_plan = fftwf_plan_dft_r2c_2d(
+                    real_size[1], real_size[0], real_array, complex_array, FFTW_ESTIMATE);
+            } else if (dim == 1) {
+                fft_plan.m_plan = fftwf_plan_dft_r2c_1d(
+                    real_size[0], real_array, complex_array, FFTW_ESTIMATE);
+            } else {
+                ABLASTR_ABORT_WITH_MESSAGE(
+                    "only dim=1 and dim=2 and dim=3 have been implemented");
+            }
+        } else if (dir == direction::C2R){
+            if (dim == 3) {
+                fft_plan.m_plan = fftwf_plan_dft_c2r_3d(
+                    real_size[2], real_size[1], real_size[0], complex_array, real_array, FFTW_ESTIMATE);
+            } else if (dim == 2) {
+                fft_plan.m_plan = fftwf_plan_dft_c2r_2d(
+                    real_size[1], real_size[0], complex_array, real_array, FFTW_ESTIMATE);
+            } else if (dim == 1) {
+                fft_plan.m_plan = fftwf_plan_dft_c2r_1d(
+                    real_size[0], complex_array, real_array, FFTW_ESTIMATE);
+            } else {
+                ABLASTR_ABORT_WITH_MESSAGE(
+                    "only dim=1 and dim=2 and dim=3 have been implemented.");
+            }
+        }
+
+        // Store meta-data in fft_plan
+        fft_plan.m_real_array = real_array;
+        fft_plan.m_complex_array = complex_array;
+        fft_plan.m_dir = dir;
+        fft_plan.m_dim = dim;
+
+        return fft_plan;
+    }
+
+    void DestroyPlan(FFTplanSingle& fft_plan)
+    {
+        fftwf_destroy_plan( fft_plan.m_plan );
+    }
+
+    void Execute(FFTplanSingle& fft_plan){
+        fftwf_execute( fft_plan.m_plan );
+    }
+#endif
 }
@@ -19,53 +19,89 @@ namespace ablastr::math::anyfft
 
     void cleanup () {/*nothing to do*/}
 
-    FFTplan CreatePlan (const amrex::IntVect& real_size, amrex::Real * const real_array,
-                        Complex * const complex_array, const direction dir, const int dim)
+    namespace
     {
-        FFTplan fft_plan;
-        ABLASTR_PROFILE("ablastr::math::anyfft::CreatePlan");
+        /** Create a oneMKL DFT descriptor of the precision of T_FFTplan
+         *  and fill the plan meta-data */
+        template <typename T_FFTplan, typename T_Real, typename T_Complex>
+        T_FFTplan create_plan (const amrex::IntVect& real_size, T_Real * const real_array,
+                               T_Complex * const complex_array, const direction dir, const int dim)
+        {
+            using VendorPlan = decltype(T_FFTplan::m_plan);
+            T_FFTplan fft_plan;
+
+            // Initialize fft_plan.m_plan with the vendor fft plan.
+            std::vector<std::int64_t> strides(dim+1);
+            if (dim == 3) {
+                fft_plan.m_plan = new std::remove_pointer_t<VendorPlan>(
+                    {std::int64_t(real_size[2]),
+                     std::int64_t(real_size[1]),
+                     std::int64_t(real_size[0])});
+                strides[0] = 0;
+                strides[1] = real_size[0] * real_size[1];
+                strides[2] = real_size[0];
+                strides[3] = 1;
+            } else if (dim == 2) {
+                fft_plan.m_plan = new std::remove_pointer_t<VendorPlan>(
+                    {std::int64_t(real_size[1]),
+                     std::int64_t(real_size[0])});
+                strides[0] = 0;
+                strides[1] = real_size[0];
+                strides[2] = 1;
+            } else if (dim == 1) {
+                strides[0] = 0;
+                strides[1] = 1;
+                fft_plan.m_plan = new std::remove_pointer_t<VendorPlan>(
+                    std::int64_t(real_size[0]));
+            } else {
+                ABLASTR_ABORT_WITH_MESSAGE("only dim2 =1, dim=2 and dim=3 have been implemented");
+            }
+
+            fft_plan.m_plan->set_value(oneapi::mkl::dft::config_param::PLACEMENT,
+                                       DFTI_NOT_INPLACE);
+            fft_plan.m_plan->set_value(oneapi::mkl::dft::config_param::FWD_STRIDES,
+                                       strides.data());
+            fft_plan.m_plan->commit(amrex::Gpu::Device::streamQueue());
+
+            // Store meta-data in fft_plan
+            fft_plan.m_real_array = real_array;
+            fft_plan.m_complex_array = complex_array;
+            fft_plan.m_dir = dir;
+            fft_plan.m_dim = dim;
+            fft_plan.m_stream = amrex::Gpu::gpuStream();
 
-        // Initialize fft_plan.m_plan with the vendor fft plan.
-        std::vector<std::int64_t> strides(dim+1);
-        if (dim == 3) {
-            fft_plan.m_plan = new std::remove_pointer_t<VendorFFTPlan>(
-                {std::int64_t(real_size[2]),
-                 std::int64_t(real_size[1]),
-                 std::int64_t(real_size[0])});
-            strides[0] = 0;
-            strides[1] = real_size[0] * real_size[1];
-            strides[2] = real_size[0];
-            strides[3] = 1;
-        } else if (dim == 2) {
-            fft_plan.m_plan = new std::remove_pointer_t<VendorFFTPlan>(
-                {std::int64_t(real_size[1]),
-                 std::int64_t(real_size[0])});
-            strides[0] = 0;
-            strides[1] = real_size[0];
-            strides[2] = 1;
-        } else if (dim == 1) {
-            strides[0] = 0;
-            strides[1] = 1;
-            fft_plan.m_plan = new std::remove_pointer_t<VendorFFTPlan>(
-                std::int64_t(real_size[0]));
-        } else {
-            ABLASTR_ABORT_WITH_MESSAGE("only dim2 =1, dim=2 and dim=3 have been implemented");
+            return fft_plan;
         }
 
-        fft_plan.m_plan->set_value(oneapi::mkl::dft::config_param::PLACEMENT,
-                                   DFTI_NOT_INPLACE);
-        fft_plan.m_plan->set_value(oneapi::mkl::dft::config_param::FWD_STRIDES,
-                                   strides.data());
-        fft_plan.m_plan->commit(amrex::Gpu::Device::streamQueue());
+        /** Execute a oneMKL DFT of the precision given by T_Real */
+        template <typename T_Real, typename T_FFTplan>
+        void execute_plan (T_FFTplan& fft_plan)
+        {
+            if (!(fft_plan.m_stream == amrex::Gpu::gpuStream())) {
+                amrex::Gpu::streamSynchronize();
+            }
 
-        // Store meta-data in fft_plan
-        fft_plan.m_real_array = real_array;
-        fft_plan.m_complex_array = complex_array;
-        fft_plan.m_dir = dir;
-        fft_plan.m_dim = dim;
-        fft_plan.m_stream = amrex::Gpu::gpuStream();
+            sycl::event r;
+            if (fft_plan.m_dir == direction::R2C) {
+                r = oneapi::mkl::dft::compute_forward(
+                    *fft_plan.m_plan,
+                    fft_plan.m_real_array,
+                    reinterpret_cast<std::complex<T_Real>*>(fft_plan.m_complex_array));
+            } else {
+                r = oneapi::mkl::dft::compute_backward(
+                    *fft_plan.m_plan,
+                    reinterpret_cast<std::complex<T_Real>*>(fft_plan.m_complex_array),
+                    fft_plan.m_real_array);
+            }
+            r.wait();
+        }
+    }
 
-        return fft_plan;
+    FFTplan CreatePlan (const amrex::IntVect& real_size, amrex::Real * const real_array,
+                        Complex * const complex_array, const direction dir, const int dim)
+    {
+        ABLASTR_PROFILE("ablastr::math::anyfft::CreatePlan");
+        return create_plan<FFTplan>(real_size, real_array, complex_array, dir, dim);
     }
 
     void DestroyPlan (FFTplan& fft_plan)
@@ -75,22 +111,25 @@ namespace ablastr::math::anyfft
 
     void Execute (FFTplan& fft_plan)
     {
-        if (!(fft_plan.m_stream == amrex::Gpu::gpuStream())) {
-            amrex::Gpu::streamSynchronize();
-        }
+        execute_plan<amrex::Real>(fft_plan);
+    }
 
-        sycl::event r;
-        if (fft_plan.m_dir == direction::R2C) {
-            r = oneapi::mkl::dft::compute_forward(
-                *fft_plan.m_plan,
-                fft_plan.m_real_array,
-                reinterpret_cast<std::complex<amrex::Real>*>(fft_plan.m_complex_array));
-        } else {
-            r = oneapi::mkl::dft::compute_backward(
-                *fft_plan.m_plan,
-                reinterpret_cast<std::complex<amrex::Real>*>(fft_plan.m_complex_array),
-                fft_plan.m_real_array);
-        }
-        r.wait();
+#ifdef ABLASTR_FFT_MIXED_PRECISION
+    FFTplanSingle CreatePlanSingle (const amrex::IntVect& real_size, float * const real_array,
+                                    ComplexSingle * const complex_array, const direction dir, const int dim)
+    {
+        ABLASTR_PROFILE("ablastr::math::anyfft::CreatePlanSingle");
+        return create_plan<FFTplanSingle>(real_size, real_array, complex_array, dir, dim);
+    }
+
+    void DestroyPlan (FFTplanSingle& fft_plan)
+    {
+        delete fft_plan.m_plan;
+    }
+
+    void Execute (FFTplanSingle& fft_plan)
+    {
+        execute_plan<float>(fft_plan);
     }
+#endif
 }
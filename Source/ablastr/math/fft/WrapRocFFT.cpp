@@ -30,40 +30,95 @@ namespace ablastr::math::anyfft
             ABLASTR_ALWAYS_ASSERT_WITH_MESSAGE(status == rocfft_status_success,
                 name + " failed! Error: " + rocfftErrorToString(status));
         }
+
+        /** Create a rocFFT plan of the given precision and fill the plan meta-data */
+        template <typename T_FFTplan, typename T_Real, typename T_Complex>
+        T_FFTplan create_plan (const amrex::IntVect& real_size, T_Real * const real_array,
+                               T_Complex * const complex_array, const direction dir, const int dim,
+                               const rocfft_precision precision)
+        {
+            T_FFTplan fft_plan;
+
+            const std::size_t lengths[] = {AMREX_D_DECL(std::size_t(real_size[0]),
+                                                        std::size_t(real_size[1]),
+                                                        std::size_t(real_size[2]))};
+
+            // Initialize fft_plan.m_plan with the vendor fft plan.
+            rocfft_status result = rocfft_plan_create(&(fft_plan.m_plan),
+                                                      rocfft_placement_notinplace,
+                                                      (dir == direction::R2C)
+                                                          ? rocfft_transform_type_real_forward
+                                                          : rocfft_transform_type_real_inverse,
+                                                      precision,
+                                                      dim, lengths,
+                                                      1, // number of transforms,
+                                                      nullptr);
+            assert_rocfft_status("rocfft_plan_create", result);
+
+            // Store meta-data in fft_plan
+            fft_plan.m_real_array = real_array;
+            fft_plan.m_complex_array = complex_array;
+            fft_plan.m_dir = dir;
+            fft_plan.m_dim = dim;
+
+            return fft_plan;
+        }
+
+        /** Execute a rocFFT plan of any precision */
+        template <typename T_FFTplan>
+        void execute_plan (T_FFTplan& fft_plan)
+        {
+            rocfft_execution_info execinfo = nullptr;
+            rocfft_status result = rocfft_execution_info_create(&execinfo);
+            assert_rocfft_status("rocfft_execution_info_create", result);
+
+            std::size_t buffersize = 0;
+            result = rocfft_plan_get_work_buffer_size(fft_plan.m_plan, &buffersize);
+            assert_rocfft_status("rocfft_plan_get_work_buffer_size", result);
+
+            void* buffer = amrex::The_Arena()->alloc(buffersize);
+            result = rocfft_execution_info_set_work_buffer(execinfo, buffer, buffersize);
+            assert_rocfft_status("rocfft_execution_info_set_work_buffer", result);
+
+            result = rocfft_execution_info_set_stream(execinfo, amrex::Gpu::gpuStream());
+            assert_rocfft_status("rocfft_execution_info_set_stream", result);
+
+            if (fft_plan.m_dir == direction::R2C) {
+                result = rocfft_execute(fft_plan.m_plan,
+                                        (void**)&(fft_plan.m_real_array), // in
+                                        (void**)&(fft_plan.m_complex_array), // out
+                                        execinfo);
+            } else if (fft_plan.m_dir == direction::C2R) {
+                result = rocfft_execute(fft_plan.m_plan,
+                                        (void**)&(fft_plan.m_complex_array), // in
+                                        (void**)&(fft_plan.m_real_array), // out
+                                        execinfo);
+            } else {
+                ABLASTR_ABORT_WITH_MESSAGE(
+                    "direction must be FFTplan::direction::R2C or FFTplan::direction::C2R");
+            }
+
+            assert_rocfft_status("rocfft_execute", result);
+
+            amrex::Gpu::streamSynchronize();
+
+            amrex::The_Arena()->free(buffer);
+
+            result = rocfft_execution_info_destroy(execinfo);
+            assert_rocfft_status("rocfft_execution_info_destroy", result);
+        }
     }
 
     FFTplan CreatePlan (const amrex::IntVect& real_size, amrex::Real * const real_array,
                         Complex * const complex_array, const direction dir, const int dim)
     {
-        FFTplan fft_plan;
-
-        const std::size_t lengths[] = {AMREX_D_DECL(std::size_t(real_size[0]),
-                                                    std::size_t(real_size[1]),
-                                                    std::size_t(real_size[2]))};
-
-        // Initialize fft_plan.m_plan with the vendor fft plan.
-        rocfft_status result = rocfft_plan_create(&(fft_plan.m_plan),
-                                                  rocfft_placement_notinplace,
-                                                  (dir == direction::R2C)
-                                                      ? rocfft_transform_type_real_forward
-                                                      : rocfft_transform_type_real_inverse,
+        return create_plan<FFTplan>(real_size, real_array, complex_array, dir, dim,
 #ifdef AMREX_USE_FLOAT
-                                                  rocfft_precision_single,
+                                    rocfft_precision_single
 #else
-                                                  rocfft_precision_double,
+                                    rocfft_precision_double
 #endif
-                                                  dim, lengths,
-                                                  1, // number of transforms,
-                                                  nullptr);
-        assert_rocfft_status("rocfft_plan_create", result);
-
-        // Store meta-data in fft_plan
-        fft_plan.m_real_array = real_array;
-        fft_plan.m_complex_array = complex_array;
-        fft_plan.m_dir = dir;
-        fft_plan.m_dim = dim;
-
-        return fft_plan;
+                                    );
     }
 
     void DestroyPlan (FFTplan& fft_plan)
@@ -73,45 +128,27 @@ namespace ablastr::math::anyfft
 
     void Execute (FFTplan& fft_plan)
     {
-        rocfft_execution_info execinfo = nullptr;
-        rocfft_status result = rocfft_execution_info_create(&execinfo);
-        assert_rocfft_status("rocfft_execution_info_create", result);
-
-        std::size_t buffersize = 0;
-        result = rocfft_plan_get_work_buffer_size(fft_plan.m_plan, &buffersize);
-        assert_rocfft_status("rocfft_plan_get_work_buffer_size", result);
-
-        void* buffer = amrex::The_Arena()->alloc(buffersize);
-        result = rocfft_execution_info_set_work_buffer(execinfo, buffer, buffersize);
-        assert_rocfft_status("rocfft_execution_info_set_work_buffer", result);
-
-        result = rocfft_execution_info_set_stream(execinfo, amrex::Gpu::gpuStream());
-        assert_rocfft_status("rocfft_execution_info_set_stream", result);
-
-        if (fft_plan.m_dir == direction::R2C) {
-            result = rocfft_execute(fft_plan.m_plan,
-                                    (void**)&(fft_plan.m_real_array), // in
-                                    (void**)&(fft_plan.m_complex_array), // out
-                                    execinfo);
-        } else if (fft_plan.m_dir == direction::C2R) {
-            result = rocfft_execute(fft_plan.m_plan,
-                                    (void**)&(fft_plan.m_complex_array), // in
-                                    (void**)&(fft_plan.m_real_array), // out
-                                    execinfo);
-        } else {
-            ABLASTR_ABORT_WITH_MESSAGE(
-                "direction must be FFTplan::direction::R2C or FFTplan::direction::C2R");
-        }
-
-        assert_rocfft_status("rocfft_execute", result);
+        execute_plan(fft_plan);
+    }
 
-        amrex::Gpu::streamSynchronize();
+#ifdef ABLASTR_FFT_MIXED_PRECISION
+    FFTplanSingle CreatePlanSingle (const amrex::IntVect& real_size, float * const real_array,
+                                    ComplexSingle * const complex_array, const direction dir, const int dim)
+    {
+        return create_plan<FFTplanSingle>(real_size, real_array, complex_array, dir, dim,
+                                          rocfft_precision_single);
+    }
 
-        amrex::The_Arena()->free(buffer);
+    void DestroyPlan (FFTplanSingle& fft_plan)
+    {
+        rocfft_plan_destroy( fft_plan.m_plan );
+    }
 
-        result = rocfft_execution_info_destroy(execinfo);
-        assert_rocfft_status("rocfft_execution_info_destroy", result);
+    void Execute (FFTplanSingle& fft_plan)
+    {
+        execute_plan(fft_plan);
     }
+#endif
 
     /** \brief This method converts a rocfftResult
      * into the corresponding string
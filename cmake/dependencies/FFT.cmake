@@ -1,4 +1,8 @@
 if(ABLASTR_FFT)
+    # Set to ON below if single-precision transforms of double-precision data
+    # are supported (ABLASTR_FFT_MIXED_PRECISION), e.g., to enable tests
+    set(WarpX_FFT_MIXED_PRECISION OFF CACHE INTERNAL "")
+
     # Helper Functions ############################################################
     #
     option(WarpX_FFTW_IGNORE_OMP "Ignore FFTW3 OpenMP support, even if found" OFF)
@@ -43,6 +47,54 @@ if(ABLASTR_FFT)
         fftw_add_define("${HAS_FFTW_OMP_LIB}")
     endfunction()
 
+    # In double precision, check if the single-precision FFTW library
+    # libfftw3f.(a|so) is shipped in the same install location. If yes, link it
+    # and set the ABLASTR_FFT_MIXED_PRECISION=1 define, which enables
+    # single-precision transforms of double-precision data (mixed precision).
+    #
+    function(fftw_check_single library_paths)
+        find_library(HAS_FFTW_SINGLE_LIB fftw3f
+            PATHS ${library_paths}
+            # see fftw_check_omp: only check the location hinted by "library_paths"
+            NO_DEFAULT_PATH
+            NO_PACKAGE_ROOT_PATH
+            NO_CMAKE_PATH
+            NO_CMAKE_ENVIRONMENT_PATH
+            NO_SYSTEM_ENVIRONMENT_PATH
+            NO_CMAKE_SYSTEM_PATH
+            NO_CMAKE_FIND_ROOT_PATH
+        )
+        if(HAS_FFTW_SINGLE_LIB)
+            message(STATUS "FFTW: Found single-precision library (mixed-precision transforms enabled)")
+            target_link_libraries(WarpX::thirdparty::FFT INTERFACE ${HAS_FFTW_SINGLE_LIB})
+            target_compile_definitions(WarpX::thirdparty::FFT INTERFACE ABLASTR_FFT_MIXED_PRECISION=1)
+            set(WarpX_FFT_MIXED_PRECISION ON CACHE INTERNAL "")
+
+            # the single-precision plans are threaded only if libfftw3f_omp is shipped as well
+            if(WarpX_COMPUTE STREQUAL OMP AND NOT WarpX_FFTW_IGNORE_OMP)
+                find_library(HAS_FFTW_SINGLE_OMP_LIB fftw3f_omp
+                    PATHS ${library_paths}
+                    NO_DEFAULT_PATH
+                    NO_PACKAGE_ROOT_PATH
+                    NO_CMAKE_PATH
+                    NO_CMAKE_ENVIRONMENT_PATH
+                    NO_SYSTEM_ENVIRONMENT_PATH
+                    NO_CMAKE_SYSTEM_PATH
+                    NO_CMAKE_FIND_ROOT_PATH
+                )
+                if(HAS_FFTW_SINGLE_OMP_LIB)
+                    message(STATUS "FFTW: Found single-precision OpenMP support")
+                    target_link_libraries(WarpX::thirdparty::FFT INTERFACE ${HAS_FFTW_SINGLE_OMP_LIB})
+                    target_compile_definitions(WarpX::thirdparty::FFT INTERFACE ABLASTR_FFTW_SINGLE_OMP=1)
+                else()
+                    message(STATUS "FFTW: Could NOT find single-precision OpenMP support")
+                endif()
+            endif()
+        else()
+            message(STATUS "FFTW: Could NOT find single-precision library (mixed-precision transforms disabled)")
+        endif()
+    endfunction()
+
 
     # Various FFT implementations that we want to use #############################
     #
@@ -121,5 +173,15 @@ if(ABLASTR_FFT)
         else()
             message(STATUS "FFTW: Did NOT search for OpenMP support (WarpX_COMPUTE!=OMP)")
         endif()
+        if(WarpX_PRECISION STREQUAL "DOUBLE" AND NOT WarpX_COMPUTE STREQUAL SYCL)
+            fftw_check_single("${WarpX_FFTW_LIBRARY_DIRS}")
+        endif()
+    endif()
+
+    # cuFFT, rocFFT and oneMKL ship both precisions in the same library
+    if(WarpX_PRECISION STREQUAL "DOUBLE" AND
+       (WarpX_COMPUTE STREQUAL CUDA OR WarpX_COMPUTE STREQUAL HIP OR WarpX_COMPUTE STREQUAL SYCL))
+        target_compile_definitions(WarpX::thirdparty::FFT INTERFACE ABLASTR_FFT_MIXED_PRECISION=1)
+        set(WarpX_FFT_MIXED_PRECISION ON CACHE INTERNAL "")
     endif()
 endif(ABLASTR_FFT)